@@ -0,0 +1,204 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * @file Arduino.h
+ * @brief Host (Linux) stand-in for the Arduino core used by the REACHER firmware.
+ *
+ * Provides the subset of the Arduino API that the core library and the paradigm
+ * sketches use, with the semantics of an Arduino UNO: 32-bit millis()/micros() that
+ * wrap, the UNO's external interrupt pins, and a Serial port. Pin levels, time and
+ * the serial backing are controlled through HostHAL.h.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define NUM_DIGITAL_PINS 20          ///< Digital pins on an UNO, including A0-A5.
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : NOT_AN_INTERRUPT))
+
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 64
+#endif
+#define SERIAL_RX_BUFFER_SIZE 64
+
+// Program memory is ordinary memory on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_ptr(p) (*(void* const*)(p))
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcpy_P strcpy
+#define memcpy_P memcpy
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+// Time
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// Digital I/O
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+
+// Interrupts
+void attachInterrupt(uint8_t interruptNum, void (*isr)(), int mode);
+void detachInterrupt(uint8_t interruptNum);
+inline void noInterrupts() {}        // ISRs only run between loop() passes on the host
+inline void interrupts() {}
+
+// Random numbers
+void randomSeed(unsigned long seed);
+long random(long howBig);
+long random(long howSmall, long howBig);
+
+/**
+ * @class String
+ * @brief Arduino String on top of std::string.
+ */
+class String {
+public:
+    String(const char* str = "") : s(str ? str : "") {}
+    String(const __FlashStringHelper* str) : s(reinterpret_cast<const char*>(str)) {}
+    String(const std::string& str) : s(str) {}
+    String(char c) : s(1, c) {}
+    String(unsigned char value, unsigned char base = DEC);
+    String(int value, unsigned char base = DEC);
+    String(unsigned int value, unsigned char base = DEC);
+    String(long value, unsigned char base = DEC);
+    String(unsigned long value, unsigned char base = DEC);
+    String(double value, unsigned char decimalPlaces = 2);
+
+    unsigned int length() const { return s.size(); }
+    const char* c_str() const { return s.c_str(); }
+    void reserve(unsigned int size) { s.reserve(size); }
+    char charAt(unsigned int index) const { return index < s.size() ? s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    String& operator+=(const String& rhs) { s += rhs.s; return *this; }
+    bool concat(const String& rhs) { s += rhs.s; return true; }
+    friend String operator+(const String& lhs, const String& rhs) { return String(lhs.s + rhs.s); }
+
+    bool equals(const String& rhs) const { return s == rhs.s; }
+    bool operator==(const String& rhs) const { return s == rhs.s; }
+    bool operator==(const char* rhs) const { return s == rhs; }
+    bool operator!=(const String& rhs) const { return s != rhs.s; }
+    bool operator!=(const char* rhs) const { return s != rhs; }
+    bool startsWith(const String& prefix) const { return s.compare(0, prefix.s.size(), prefix.s) == 0; }
+    bool endsWith(const String& suffix) const {
+        return s.size() >= suffix.s.size() && s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0;
+    }
+    int indexOf(char c) const { size_t i = s.find(c); return i == std::string::npos ? -1 : (int)i; }
+    String substring(unsigned int from) const { return from < s.size() ? String(s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        return from < to && from < s.size() ? String(s.substr(from, to - from)) : String();
+    }
+    long toInt() const { return atol(s.c_str()); }
+    void trim();
+
+private:
+    std::string s;
+};
+
+/**
+ * @class Print
+ * @brief Formatted output on top of a byte sink.
+ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write(reinterpret_cast<const uint8_t*>(str), strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write(reinterpret_cast<const uint8_t*>(buffer), size); }
+
+    size_t print(const __FlashStringHelper* str) { return write(reinterpret_cast<const char*>(str)); }
+    size_t print(const String& str) { return write(str.c_str(), str.length()); }
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(unsigned char value, int base = DEC) { return print(static_cast<unsigned long>(value), base); }
+    size_t print(int value, int base = DEC) { return print(static_cast<long>(value), base); }
+    size_t print(unsigned int value, int base = DEC) { return print(static_cast<unsigned long>(value), base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int decimalPlaces = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+/**
+ * @class Stream
+ * @brief Byte input on top of Print.
+ */
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+/**
+ * @class HardwareSerial
+ * @brief UART stand-in backed by file descriptors (a pipe, a file or a pty).
+ *
+ * Output is buffered and written out by hostSerialFlush(); the transmit buffer never
+ * fills, so availableForWrite() always reports a free UNO-sized buffer.
+ */
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    int available() override;
+    int read() override;
+    int peek() override;
+    int availableForWrite() { return SERIAL_TX_BUFFER_SIZE - 1; }
+    void flush();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+// Sketch entry points
+void setup();
+void loop();
+
+#endif // HOST_ARDUINO_H
\ No newline at end of file
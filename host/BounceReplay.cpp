@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "HostHAL.h"
+
+/*
+  Replays recorded contact-bounce traces through a paradigm sketch's input path and
+  checks how many presses or licks it logs for each.
+
+  Usage: bounce-replay TRACE...
+
+  A trace is a CSV of the edges seen on one input, as a logic analyzer exports them:
+  one "<time us>,<level>" row per edge, with the time from the start of the trace and
+  the level (0 or 1) the input went to. The input starts at its idle level (HIGH for a
+  lever, LOW for the lick circuit). '#' lines are comments, and one of them names the
+  input and the number of events the sketch should log:
+    # input=RH|LH|LICK events=N
+  A "time_us,level" header row is skipped.
+
+  Links a paradigm sketch, runs its setup(), and over the simulated serial port links,
+  arms both levers and the lick circuit and starts the program. The traces are then
+  played one after another, a second apart, on the virtual clock: each edge is driven
+  at its own microsecond and the loop runs once a millisecond, so the sketch sees
+  the bounce exactly as it would on the board. Prints one CSV row per trace:
+    TRACE,<file>,<input>,<expected>,<logged>,<detection lag ms>
+  where the lag runs from the trace's first active edge to the first logged event's
+  start. Events are dated by the first sample of their edge, so the lag is at most the
+  1 ms sampling tick however long the bounce or the debounce time. Exits with 1 if any
+  count differs or any lag is over a millisecond. Built with INPUT_SAMPLER_VERTICAL_DEBOUNCE
+  the lag is not checked: the vertical counter can only date an edge by the first of its
+  four samples (see InputSampler.h), so bounce longer than a debouncer interval shows.
+*/
+
+void setup();
+void loop();
+
+const uint64_t TRACE_GAP = 1000000; ///< Idle time before and after each trace (us).
+
+const uint8_t RH_LEVER_PIN = 10;    ///< Right-hand lever pin, as wired in the sketch.
+const uint8_t LH_LEVER_PIN = 13;    ///< Left-hand lever pin, as wired in the sketch.
+const uint8_t LICK_CIRCUIT_PIN = 5; ///< Lick circuit pin, as wired in the sketch.
+
+extern uint32_t differenceFromStartTime; ///< Program start time (ms), set by the sketch.
+
+/**
+ * @struct Edge
+ * @brief A recorded transition on the traced input.
+ */
+struct Edge {
+    uint64_t time;                  ///< Time from the start of the trace (us).
+    uint8_t level;                  ///< Level the input went to.
+};
+
+/**
+ * @struct Trace
+ * @brief A recorded input and the events it should produce.
+ */
+struct Trace {
+    std::string path;               ///< File the trace was read from.
+    std::string input;              ///< "RH", "LH" or "LICK".
+    uint8_t pin;                    ///< Input pin replayed.
+    uint8_t activeLevel;            ///< Level while in contact.
+    long expected;                  ///< Events the sketch should log.
+    std::vector<Edge> edges;        ///< Recorded transitions, in time order.
+};
+
+static const char* const EVENT_PREFIXES[] = {"RH_LEVER,", "LH_LEVER,", "LICK_CIRCUIT,LICK,"}; ///< Logged events per input.
+
+static std::string serialLine;      ///< Serial output not yet ended by a newline.
+static std::vector<std::pair<std::string, uint32_t>> logged; ///< Prefix and start (ms) of each logged event.
+
+/**
+ * @brief Collects the press and lick events from the sketch's serial output.
+ * @param data Output bytes.
+ * @param size Number of bytes.
+ */
+static void collect(const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] != '\n') {
+            serialLine += data[i];
+            continue;
+        }
+        for (const char* prefix : EVENT_PREFIXES) {
+            if (serialLine.compare(0, strlen(prefix), prefix) == 0) {
+                const char* start = serialLine.c_str() + strlen(prefix);
+                if (prefix != EVENT_PREFIXES[2]) { // Skip the press type
+                    start = strchr(start, ',');
+                    start = start ? start + 1 : "";
+                }
+                logged.push_back(std::make_pair(std::string(prefix), strtoul(start, nullptr, 10)));
+            }
+        }
+        serialLine.clear();
+    }
+}
+
+/**
+ * @brief Reads a trace file.
+ * @param path Trace path.
+ * @param trace Receives the trace.
+ * @return Boolean indicating success; errors are reported on stderr.
+ */
+static bool loadTrace(const char* path, Trace& trace) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "bounce-replay: cannot open %s\n", path);
+        return false;
+    }
+    trace.path = path;
+    trace.expected = -1;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') {
+            const char* input = strstr(line, "input=");
+            const char* events = strstr(line, "events=");
+            if (input) {
+                trace.input = std::string(input + 6, strcspn(input + 6, " \t\r\n"));
+            }
+            if (events) {
+                trace.expected = strtol(events + 7, nullptr, 10);
+            }
+            continue;
+        }
+        char* end;
+        uint64_t time = strtoull(line, &end, 10);
+        if (end == line || *end != ',') {
+            continue; // Header or blank row
+        }
+        Edge edge = {time, static_cast<uint8_t>(strtoul(end + 1, nullptr, 10) ? HIGH : LOW)};
+        if (!trace.edges.empty() && time < trace.edges.back().time) {
+            fprintf(stderr, "bounce-replay: %s: edges out of order at %llu us\n", path,
+                    static_cast<unsigned long long>(time));
+            fclose(file);
+            return false;
+        }
+        trace.edges.push_back(edge);
+    }
+    fclose(file);
+    if (trace.input == "RH" || trace.input == "LH") {
+        trace.pin = trace.input == "RH" ? RH_LEVER_PIN : LH_LEVER_PIN;
+        trace.activeLevel = LOW;
+    } else if (trace.input == "LICK") {
+        trace.pin = LICK_CIRCUIT_PIN;
+        trace.activeLevel = HIGH;
+    } else {
+        fprintf(stderr, "bounce-replay: %s: no \"# input=RH|LH|LICK\" line\n", path);
+        return false;
+    }
+    if (trace.expected < 0) {
+        fprintf(stderr, "bounce-replay: %s: no \"# events=N\" line\n", path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the loop once a millisecond up to a time, without driving inputs.
+ * @param until Time to run to (us since hostBegin()).
+ */
+static void runUntil(uint64_t until) {
+    while (hostMicros() + (1000 - hostMicros() % 1000) <= until) {
+        hostAdvance(1000 - hostMicros() % 1000);
+        loop();
+        hostSerialFlush();
+    }
+    if (hostMicros() < until) { // A pass that blocked may already have run past it
+        hostAdvance(until - hostMicros());
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s TRACE...\n", argv[0]);
+        return 2;
+    }
+    std::vector<Trace> traces(argc - 1);
+    for (int i = 1; i < argc; i++) {
+        if (!loadTrace(argv[i], traces[i - 1])) {
+            return 2;
+        }
+    }
+
+    hostBegin(HOST_VIRTUAL_TIME);
+    hostSerialCapture(collect);
+    setup();
+    const char* const sessionCommands[] = {"LINK", "ARM_LEVER_RH", "ARM_LEVER_LH", "ARM_LICK_CIRCUIT", "START-PROGRAM"};
+    for (size_t i = 0; i < sizeof(sessionCommands) / sizeof(sessionCommands[0]); i++) {
+        hostSerialInject(sessionCommands[i], strlen(sessionCommands[i]));
+        hostSerialInject("\n", 1);
+        runUntil(hostMicros() + 1000);
+    }
+
+    bool ok = true;
+    for (const Trace& trace : traces) {
+        uint64_t origin = hostMicros() + TRACE_GAP;
+        runUntil(origin);
+        logged.clear();
+        for (const Edge& edge : trace.edges) {
+            runUntil(origin + edge.time);
+            hostDrivePin(trace.pin, edge.level);
+        }
+        runUntil(hostMicros() + TRACE_GAP);
+
+        const char* prefix = EVENT_PREFIXES[trace.input == "RH" ? 0 : trace.input == "LH" ? 1 : 2];
+        long count = 0;
+        uint32_t firstStart = 0;
+        for (const auto& event : logged) {
+            if (event.first == prefix && count++ == 0) { // Events are logged in order
+                firstStart = event.second;
+            }
+        }
+        long lag = -1;
+        for (const Edge& edge : trace.edges) {
+            if (edge.level == trace.activeLevel) {
+                uint64_t firstActive = (origin + edge.time) / 1000 - differenceFromStartTime;
+                lag = count ? static_cast<long>(firstStart) - static_cast<long>(firstActive) : -1;
+                break;
+            }
+        }
+        const char* name = strrchr(trace.path.c_str(), '/');
+        printf("TRACE,%s,%s,%ld,%ld,%ld\n", name ? name + 1 : trace.path.c_str(), trace.input.c_str(),
+               trace.expected, count, lag);
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+        ok = ok && count == trace.expected;
+#else
+        ok = ok && count == trace.expected && lag <= 1;
+#endif
+    }
+    return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+#include <vector>
+#include "HostHAL.h"
+#include "Session.h"
+#include "Schedule.h"
+
+/*
+  Compares command dispatch before and after the move to a sorted table, and checks
+  that a command session never holds up loop().
+
+  Usage: command-bench [--lookups N]
+
+  Dispatch: every command in operant_FR's tables (schedule and shared), with a
+  parameter where it takes one, and a few unknown commands are looked up N times each
+  (default 20000) with the linear strcmp()/strncmp() scan the sketches used before and
+  with findCommand(). Both must find the same handler for every line; the CPU time per
+  lookup is printed for each. On an x86 host the times only show the relative cost.
+
+  Session: the sketch is linked, armed, run and unlinked over the simulated serial
+  port with every byte arriving at its time on a 115200 baud line (86.8 us per byte),
+  including an unknown command and a line too long for the command buffer. The loop
+  runs once per scheduler tick. Any delay() or blocking read inside loop() would move
+  the virtual clock, so the longest pass in virtual time is how long loop() was held
+  up. The sketches used to spend at least delay(50) on every command, plus the rest of
+  the line at the baud rate in readBytesUntil(); that figure is printed alongside.
+  Prints
+    DISPATCH,<lines>,LINEAR,<ns/lookup>,SORTED,<ns/lookup>
+    SESSION,<commands>,<longest pass us>,<old blocking estimate ms>,<invalid replies>
+  and exits with 1 if the lookups disagree, a pass blocked or the two bad lines were
+  not both answered as invalid.
+*/
+
+void setup();
+void loop();
+
+const double BYTE_MICROS = 10e6 / 115200; ///< Time of one byte at 115200 baud, 8N1 (us).
+const uint32_t OLD_COMMAND_DELAY = 50;    ///< delay() after every command in the old loop (ms).
+
+static uint32_t invalidReplies = 0;       ///< ">>> Command [...] is invalid." lines seen.
+static std::string serialLine;            ///< Serial output not yet ended by a newline.
+
+/**
+ * @brief Counts invalid-command replies in the sketch's serial output.
+ * @param data Output bytes.
+ * @param size Number of bytes.
+ */
+static void collect(const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] != '\n') {
+            serialLine += data[i];
+            continue;
+        }
+        invalidReplies += serialLine.find("] is invalid.") != std::string::npos;
+        serialLine.clear();
+    }
+}
+
+/**
+ * @brief Finds a command the way the sketches did before the sorted table.
+ *
+ * Scans the table in order; prefixes ending in ':' match the start of the line with
+ * strncmp(), others the whole line with strcmp().
+ *
+ * @param table Command table.
+ * @param count Number of entries.
+ * @param line Null-terminated command line.
+ * @return Handler of the first matching command, or nullptr.
+ */
+static CommandHandler findLinear(const Command* table, size_t count, const char* line) {
+    for (size_t i = 0; i < count; i++) {
+        size_t prefixLength = strlen(table[i].prefix);
+        if (table[i].prefix[prefixLength - 1] == ':' ? strncmp(line, table[i].prefix, prefixLength) == 0
+                                                     : strcmp(line, table[i].prefix) == 0) {
+            return table[i].handler;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Looks a line up in the schedule table, then the shared one.
+ * @param line Command line.
+ * @param linear Whether to use the old linear scan instead of findCommand().
+ * @return Handler, or nullptr for an unknown command.
+ */
+static CommandHandler dispatch(const char* line, bool linear) {
+    CommandHandler handler = linear ? findLinear(scheduleCommands, SCHEDULE_COMMAND_COUNT, line)
+                                    : findCommand(scheduleCommands, SCHEDULE_COMMAND_COUNT, line);
+    if (!handler) {
+        handler = linear ? findLinear(coreCommands, CORE_COMMAND_COUNT, line)
+                         : findCommand(coreCommands, CORE_COMMAND_COUNT, line);
+    }
+    return handler;
+}
+
+/**
+ * @brief Returns the time on the process CPU clock.
+ * @return Time (ns).
+ */
+static uint64_t cpuNanos() {
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * @brief Times one lookup method over every line.
+ * @param lines Command lines.
+ * @param lookups Lookups per line.
+ * @param linear Whether to use the old linear scan.
+ * @return CPU time per lookup (ns).
+ */
+static double timeLookups(const std::vector<std::string>& lines, size_t lookups, bool linear) {
+    size_t found = 0; // Keeps the optimizer from discarding the work
+    uint64_t start = cpuNanos();
+    for (size_t n = 0; n < lookups; n++) {
+        for (const std::string& line : lines) {
+            found += dispatch(line.c_str(), linear) != nullptr;
+        }
+    }
+    double nanos = static_cast<double>(cpuNanos() - start) / (lookups * lines.size());
+    return found ? nanos : -1;
+}
+
+int main(int argc, char** argv) {
+    size_t lookups = 20000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lookups") == 0 && i + 1 < argc) {
+            lookups = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--lookups N]\n", argv[0]);
+            return 2;
+        }
+    }
+    bool ok = true;
+
+    std::vector<std::string> lines;
+    const Command* const tables[] = {scheduleCommands, coreCommands};
+    const size_t counts[] = {SCHEDULE_COMMAND_COUNT, CORE_COMMAND_COUNT};
+    for (size_t t = 0; t < 2; t++) {
+        for (size_t i = 0; i < counts[t]; i++) {
+            std::string line = tables[t][i].prefix;
+            lines.push_back(line[line.size() - 1] == ':' ? line + "1000" : line);
+        }
+    }
+    const char* const unknown[] = {"ARM", "LASER_STIM_MODE", "SET_RATIO", "ZZZ", "START-PROGRAM:1"};
+    for (const char* line : unknown) {
+        lines.push_back(line);
+    }
+    for (const std::string& line : lines) {
+        if (dispatch(line.c_str(), true) != dispatch(line.c_str(), false)) {
+            fprintf(stderr, "command-bench: lookups disagree on \"%s\"\n", line.c_str());
+            ok = false;
+        }
+    }
+    double linearNanos = timeLookups(lines, lookups, true);
+    double sortedNanos = timeLookups(lines, lookups, false);
+    printf("DISPATCH,%zu,LINEAR,%.1f,SORTED,%.1f\n", lines.size(), linearNanos, sortedNanos);
+
+    const std::string tooLong = "SET_FREQUENCY_CS:" + std::string(COMMAND_BUFFER_SIZE, '1');
+    const char* const session[] = {
+        "LINK", "ARM_LEVER_RH", "ARM_LEVER_LH", "ARM_CS", "ARM_PUMP", "ARM_LICK_CIRCUIT", "SET_RATIO:5",
+        "SET_FREQUENCY_CS:8000", "SET_DURATION_CS:1600", "SET_TIMEOUT_PERIOD_LENGTH:20000",
+        "SET_TRACE_INTERVAL:0", "BOGUS_COMMAND", tooLong.c_str(), "START-PROGRAM", "STATS", "END-PROGRAM",
+        "UNLINK"
+    };
+    const size_t commandCount = sizeof(session) / sizeof(session[0]);
+    std::string stream;
+    double oldBlocking = 0;
+    for (const char* command : session) {
+        stream += command;
+        stream += '\n';
+        size_t readLength = strlen(command) < COMMAND_BUFFER_SIZE - 1 ? strlen(command) : COMMAND_BUFFER_SIZE - 1;
+        double blocking = readLength * BYTE_MICROS / 1000 + OLD_COMMAND_DELAY; // Rest of the line, then delay()
+        oldBlocking = blocking > oldBlocking ? blocking : oldBlocking;
+    }
+
+    hostBegin(HOST_VIRTUAL_TIME);
+    hostSerialCapture(collect);
+    setup();
+    const uint64_t origin = hostMicros();
+    size_t sent = 0;
+    uint64_t longestPass = 0;
+    while (sent < stream.size() || hostMicros() < origin + stream.size() * BYTE_MICROS + 100000) {
+        hostAdvance(1000 - hostMicros() % 1000);
+        while (sent < stream.size() && origin + static_cast<uint64_t>((sent + 1) * BYTE_MICROS) <= hostMicros()) {
+            hostSerialInject(&stream[sent++], 1);
+        }
+        uint64_t before = hostMicros();
+        loop();
+        hostSerialFlush();
+        uint64_t pass = hostMicros() - before;
+        longestPass = pass > longestPass ? pass : longestPass;
+    }
+    printf("SESSION,%zu,%llu,%.1f,%u\n", commandCount, static_cast<unsigned long long>(longestPass), oldBlocking,
+           invalidReplies);
+    if (longestPass > 0 || invalidReplies != 2) {
+        fprintf(stderr, "command-bench: %s\n", longestPass > 0 ? "loop() blocked" : "bad lines not answered as invalid");
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include "HostHAL.h"
+#include "Session.h"
+
+/*
+  Runs laser CYCLE mode for a long session on the virtual clock, with the loop made
+  late at random and the animal pressing for rewards, and checks that the ON/OFF
+  epochs stay on the program start's grid.
+
+  Usage: cycle-soak [--hours H] [--duration S] [--stall-rate P] [--stall-ms M]
+                    [--press-rate R] [--seed N]
+
+  Links a paradigm sketch, runs its setup(), and over the simulated serial port links,
+  arms the right-hand lever, cue, pump and the laser in cycle mode with S-second
+  epochs (default 30) and starts the program. Every scheduler tick the loop runs once,
+  except that with probability P (default 0.001) it is first held up for 1 to M ms
+  (default 50), as a long serial burst or a blocking call would. The right-hand lever
+  is pressed for 150 ms at exponentially distributed intervals, R presses per second
+  (default 0.05), so rewards (and the laser restarts they request) land anywhere in an
+  epoch. The run lasts H simulated hours (default 24).
+
+  After every pass the laser pin is sampled. Each train's first rising edge must fall
+  in an ON epoch (even k, from start + k * S), and its delay from the start of that
+  epoch is the onset lag. Unless the loop was held up just before it, the pass that
+  starts each train must run exactly at start + k * S; the first, which follows the
+  START-PROGRAM command, one tick after the start. (The host has no Timer1, so its pin
+  follows a tick later; on the board the first edge is 20 us after the start.)
+  Prints one CSV row:
+    SOAK,<hours>,<presses>,<rewards>,<epochs>,<late epochs>,<max detection lag ms>,
+    <max onset lag ms>,<drift ms>
+  where the epochs and detection lag are the firmware's own count (as reported by
+  SCHEDULER_STATS) and the drift is the offset of the firmware's current period from
+  the grid at the end of the run. Exits with 1 if the drift is not 0, a train started
+  in an OFF epoch or a train started late without a hold-up.
+*/
+
+void setup();
+void loop();
+
+const uint64_t PRESS_HOLD = 150; ///< Time each press holds the lever down (ms).
+
+/**
+ * @brief Discards the sketch's serial output.
+ * @param data Output bytes.
+ * @param size Number of bytes.
+ */
+static void discard(const char* data, size_t size) {
+    (void)data;
+    (void)size;
+}
+
+/**
+ * @brief Moves the clock to the next scheduler tick and runs one loop pass.
+ */
+static void step() {
+    hostAdvance(1000 - hostMicros() % 1000);
+    loop();
+    hostSerialFlush();
+}
+
+int main(int argc, char** argv) {
+    double hours = 24;
+    uint32_t duration = 30;
+    double stallRate = 0.001;
+    uint32_t stallMillis = 50;
+    double pressRate = 0.05;
+    unsigned long seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--hours") == 0 && i + 1 < argc) {
+            hours = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            duration = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--stall-rate") == 0 && i + 1 < argc) {
+            stallRate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--stall-ms") == 0 && i + 1 < argc) {
+            stallMillis = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--press-rate") == 0 && i + 1 < argc) {
+            pressRate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--hours H] [--duration S] [--stall-rate P] [--stall-ms M] [--press-rate R] [--seed N]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (duration == 0 || stallMillis == 0) {
+        fprintf(stderr, "%s: --duration and --stall-ms must be at least 1\n", argv[0]);
+        return 2;
+    }
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution stall(stallRate);
+    std::uniform_int_distribution<uint32_t> stallLength(1, stallMillis);
+    std::exponential_distribution<double> pressInterval(pressRate > 0 ? pressRate : 1);
+
+    hostBegin(HOST_VIRTUAL_TIME);
+    hostSerialCapture(discard);
+    setup();
+    char durationCommand[32];
+    snprintf(durationCommand, sizeof(durationCommand), "LASER_DURATION:%u", duration);
+    const char* const sessionCommands[] = {
+        "LINK", "ARM_LEVER_RH", "ARM_CS", "ARM_PUMP", "ARM_LASER", "LASER_STIM_MODE_CYCLE", durationCommand,
+        "START-PROGRAM"
+    };
+    for (size_t i = 0; i < sizeof(sessionCommands) / sizeof(sessionCommands[0]); i++) {
+        hostSerialInject(sessionCommands[i], strlen(sessionCommands[i]));
+        hostSerialInject("\n", 1);
+        step();
+    }
+
+    const uint64_t epochMillis = static_cast<uint64_t>(duration) * 1000;
+    const uint64_t anchor = differenceFromStartTime;
+    const uint64_t end = anchor + static_cast<uint64_t>(hours * 3600000.0);
+    uint64_t lastTrainEpoch = UINT64_MAX;
+    uint64_t maxOnsetLag = 0;
+    bool offEpochTrain = false;
+    uint64_t lateOnsets = 0;
+    bool wasPulsing = false;
+    bool wasHigh = false;
+    uint64_t nextPress = pressRate > 0 ? anchor + static_cast<uint64_t>(pressInterval(rng) * 1000) : UINT64_MAX;
+    uint64_t releaseAt = 0;
+    uint64_t presses = 0;
+    uint64_t rewards = 0;
+    bool pumpWasOn = false;
+    while (hostMicros() / 1000 < end) {
+        bool stalled = stall(rng);
+        if (stalled) {
+            hostAdvance(static_cast<uint64_t>(stallLength(rng)) * 1000);
+        }
+        uint64_t nowMillis = hostMicros() / 1000;
+        if (releaseAt > 0 && nowMillis >= releaseAt) {
+            hostReleasePin(RH_LEVER_PIN);
+            releaseAt = 0;
+            nextPress = nowMillis + static_cast<uint64_t>(pressInterval(rng) * 1000);
+        } else if (releaseAt == 0 && nowMillis >= nextPress) {
+            hostDrivePin(RH_LEVER_PIN, LOW);
+            releaseAt = nowMillis + PRESS_HOLD;
+            presses++;
+        }
+        step();
+        bool pumpOn = hostPinLevel(PUMP_PIN) == HIGH;
+        rewards += pumpOn && !pumpWasOn;
+        pumpWasOn = pumpOn;
+        bool pulsing = laser.isPulsing();
+        if (pulsing && !wasPulsing && !stalled) {
+            uint64_t since = hostMicros() / 1000 - anchor;
+            uint64_t expected = since < epochMillis ? 1 : 0; // START-PROGRAM is handled after the pass's tasks
+            if (since % epochMillis != expected && lateOnsets++ < 10) {
+                fprintf(stderr, "cycle-soak: epoch %llu train started %llu ms after start + k * duration\n",
+                        static_cast<unsigned long long>(since / epochMillis),
+                        static_cast<unsigned long long>(since % epochMillis));
+            }
+        }
+        wasPulsing = pulsing;
+        bool high = hostPinLevel(LASER_PIN) == HIGH;
+        if (high && !wasHigh) {
+            uint64_t since = hostMicros() / 1000 - anchor;
+            uint64_t epoch = since / epochMillis;
+            if (epoch != lastTrainEpoch) { // First rising edge in this epoch
+                lastTrainEpoch = epoch;
+                offEpochTrain = offEpochTrain || epoch % 2 != 0;
+                uint64_t onsetLag = since - epoch * epochMillis;
+                if (onsetLag > maxOnsetLag) {
+                    maxOnsetLag = onsetLag;
+                }
+            }
+        }
+        wasHigh = high;
+    }
+
+    uint64_t since = laser.getStimStart() - anchor;
+    int64_t drift = static_cast<int64_t>(since % epochMillis);
+    bool phaseError = laser.getCycleUp() != ((since / epochMillis) % 2 == 0);
+    printf("SOAK,%.1f,%llu,%llu,%u,%u,%u,%llu,%lld\n", hours, static_cast<unsigned long long>(presses),
+           static_cast<unsigned long long>(rewards), laser.getCycleEpochs(), laser.getLateCycles(),
+           laser.getMaxCycleLag(), static_cast<unsigned long long>(maxOnsetLag), static_cast<long long>(drift));
+    if (lateOnsets > 0) {
+        fprintf(stderr, "cycle-soak: %llu trains started late without a hold-up\n",
+                static_cast<unsigned long long>(lateOnsets));
+        return 1;
+    }
+    if (drift != 0 || phaseError || offEpochTrain) {
+        fprintf(stderr, "cycle-soak: %s\n", offEpochTrain ? "train started in an OFF epoch" : "schedule drifted");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
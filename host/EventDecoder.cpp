@@ -0,0 +1,143 @@
+#include "EventDecoder.h"
+
+/**
+ * @brief Decodes a COBS-encoded buffer.
+ *
+ * Each code byte gives the distance to the next zero; a code of 0xFF is a full run
+ * with no zero after it. The zero implied after the last run is not part of the data.
+ *
+ * @param encoded Encoded bytes, without delimiters.
+ * @param length Number of encoded bytes.
+ * @param data Output buffer of at least length bytes.
+ * @return Number of decoded bytes, or 0 if the encoding is malformed.
+ */
+size_t cobsDecode(const uint8_t* encoded, size_t length, uint8_t* data) {
+    size_t readIndex = 0;
+    size_t writeIndex = 0;
+    while (readIndex < length) {
+        uint8_t code = encoded[readIndex++];
+        if (code == 0 || readIndex + code - 1 > length) {
+            return 0;
+        }
+        for (uint8_t i = 1; i < code; i++) {
+            if (encoded[readIndex] == 0) {
+                return 0;
+            }
+            data[writeIndex++] = encoded[readIndex++];
+        }
+        if (code != 0xFF && readIndex < length) {
+            data[writeIndex++] = 0;
+        }
+    }
+    return writeIndex;
+}
+
+/**
+ * @brief Reads a little-endian 64-bit value from a buffer.
+ *
+ * @param buffer Source buffer.
+ * @return Value read.
+ */
+static uint64_t getUint64(const uint8_t* buffer) {
+    uint64_t value = 0;
+    for (uint8_t i = 8; i > 0; i--) {
+        value = (value << 8) | buffer[i - 1];
+    }
+    return value;
+}
+
+/**
+ * @brief Constructs a decoder outside any frame.
+ */
+EventDecoder::EventDecoder() : frameLength(0), inFrame(false), event(), badFrames(0) {}
+
+/**
+ * @brief Decodes the collected frame into event.
+ *
+ * @return True if it decoded to a record with a matching CRC.
+ */
+bool EventDecoder::decodeFrame() {
+    uint8_t payload[EVENT_FRAME_SIZE];
+    if (frameLength > EVENT_FRAME_SIZE - 2 ||
+        cobsDecode(frame, frameLength, payload) != EVENT_PAYLOAD_SIZE + 2) {
+        return false;
+    }
+    uint16_t crc = payload[EVENT_PAYLOAD_SIZE] | (payload[EVENT_PAYLOAD_SIZE + 1] << 8);
+    if (crc != crc16(payload, EVENT_PAYLOAD_SIZE)) {
+        return false;
+    }
+    event.type = payload[0];
+    event.source = payload[1];
+    event.detail = payload[2];
+    event.start = getUint64(&payload[3]);
+    event.end = getUint64(&payload[11]);
+    return true;
+}
+
+/**
+ * @brief Consumes one byte of the stream.
+ *
+ * @param byte Received byte.
+ * @return What the byte completed.
+ */
+DECODE_RESULT EventDecoder::feed(uint8_t byte) {
+    if (byte == 0x00) {
+        text.clear(); // A line cut short by a frame is lost
+        if (!inFrame || frameLength == 0) {
+            inFrame = true;
+            return DECODE_NONE;
+        }
+        bool decoded = decodeFrame();
+        frameLength = 0;
+        if (!decoded) {
+            badFrames++;
+            return DECODE_BAD_FRAME; // Stay in a frame in case this 0x00 opens the next
+        }
+        inFrame = false;
+        return DECODE_EVENT;
+    }
+    if (inFrame) {
+        if (frameLength < sizeof(frame)) {
+            frame[frameLength] = byte;
+        }
+        frameLength++;
+        return DECODE_NONE;
+    }
+    if (byte == '\n') {
+        if (!text.empty() && text[text.size() - 1] == '\r') {
+            text.resize(text.size() - 1);
+        }
+        lastText.swap(text);
+        text.clear();
+        return DECODE_TEXT;
+    }
+    text += static_cast<char>(byte);
+    return DECODE_NONE;
+}
+
+/**
+ * @brief Gets the event from the last DECODE_EVENT.
+ *
+ * @return Decoded event.
+ */
+const EventRecord& EventDecoder::getEvent() const {
+    return event;
+}
+
+/**
+ * @brief Gets the line from the last DECODE_TEXT.
+ *
+ * @return Text line, without CR/LF.
+ */
+const std::string& EventDecoder::getText() const {
+    return lastText;
+}
+
+/**
+ * @brief Gets the number of frames rejected so far.
+ *
+ * @return Bad frame count.
+ */
+uint32_t EventDecoder::getBadFrames() const {
+    return badFrames;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef EVENT_DECODER_H
+#define EVENT_DECODER_H
+
+#include <string>
+#include "Event_Utils.h"
+
+/**
+ * @file EventDecoder.h
+ * @brief Host-side reader for the serial stream, splitting text lines from binary event frames.
+ *
+ * Bytes are fed one at a time as they arrive. A 0x00 outside a frame opens one; the
+ * next 0x00 after at least one byte closes it, and the bytes between are COBS-decoded
+ * and checked against their CRC-16 (see Event_Utils.h). Consecutive 0x00s (the close
+ * of one frame and the open of the next) are a single boundary. Anything else is text,
+ * returned a line at a time without its CR/LF.
+ *
+ * A frame that fails to decode leaves the decoder inside a frame, so a frame whose
+ * closing delimiter was lost costs only itself: the next frame's opening 0x00 ends it
+ * and that frame is read normally. Starting mid-frame, the tail of the frame reads as
+ * text up to its closing 0x00, after which frames are found again.
+ */
+
+/**
+ * @enum DECODE_RESULT
+ * @brief Defines what a byte completed, if anything.
+ */
+enum DECODE_RESULT { DECODE_NONE,     ///< Nothing completed yet.
+                     DECODE_EVENT,    ///< A frame decoded; see getEvent().
+                     DECODE_TEXT,     ///< A text line ended; see getText().
+                     DECODE_BAD_FRAME ///< A frame ended but was malformed or failed its CRC.
+};
+
+/**
+ * @class EventDecoder
+ * @brief Incremental decoder for the mixed text/binary serial stream.
+ */
+class EventDecoder {
+private:
+    std::string text;                                   ///< Text line being collected.
+    std::string lastText;                               ///< Last complete text line.
+    uint8_t frame[EVENT_FRAME_SIZE];                    ///< Encoded frame bytes being collected.
+    size_t frameLength;                                 ///< Bytes in frame, or more if it overran.
+    bool inFrame;                                       ///< Between an opening and closing 0x00.
+    EventRecord event;                                  ///< Last decoded event.
+    uint32_t badFrames;                                 ///< Frames rejected since construction.
+
+    /**
+     * @brief Decodes the collected frame into event.
+     * @return True if it decoded to a record with a matching CRC.
+     */
+    bool decodeFrame();
+
+public:
+    /**
+     * @brief Constructs a decoder outside any frame.
+     */
+    EventDecoder();
+
+    /**
+     * @brief Consumes one byte of the stream.
+     * @param byte Received byte.
+     * @return What the byte completed.
+     */
+    DECODE_RESULT feed(uint8_t byte);
+
+    /**
+     * @brief Gets the event from the last DECODE_EVENT.
+     * @return Decoded event.
+     */
+    const EventRecord& getEvent() const;
+
+    /**
+     * @brief Gets the line from the last DECODE_TEXT.
+     * @return Text line, without CR/LF.
+     */
+    const std::string& getText() const;
+
+    /**
+     * @brief Gets the number of frames rejected so far.
+     * @return Bad frame count.
+     */
+    uint32_t getBadFrames() const;
+};
+
+/**
+ * @brief Decodes a COBS-encoded buffer.
+ * @param encoded Encoded bytes, without delimiters.
+ * @param length Number of encoded bytes.
+ * @param data Output buffer of at least length bytes.
+ * @return Number of decoded bytes, or 0 if the encoding is malformed.
+ */
+size_t cobsDecode(const uint8_t* encoded, size_t length, uint8_t* data);
+
+#endif // EVENT_DECODER_H
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "EventDecoder.h"
+
+/*
+  Checks the binary event stream against the host decoder in EventDecoder.h.
+
+  Usage: event-test [--events N] [--seed S]
+
+  Round trip: N random records (default 100000), with timestamps that are often small
+  or contain zero bytes so COBS has runs to split, are built with encodeEventFrame(),
+  fed to the decoder and compared field by field. Mixed stream: text event lines and
+  plain messages are interleaved with frames, and must come back in order, unchanged. Corruption: every
+  single-bit flip of every byte between a frame's delimiters must be rejected, and the
+  frame after it must still decode. Resync: a stream that starts at every offset inside
+  a frame, and a frame cut short before its closing delimiter, must still decode every
+  frame after it. Also checks crc16() against the CRC-16/CCITT-FALSE check value (0x29B1 for
+  "123456789"). Prints
+    EVENTS,<round trips>,<corruptions rejected>,<resyncs>
+  and exits with 1 on any failure.
+*/
+
+EVENT_FORMAT eventFormat = TEXT_FORMAT; ///< Required by Event_Utils; unused here.
+EventQueue eventQueue;                  ///< Required by Event_Utils; unused here.
+
+static uint32_t failures = 0;           ///< Checks that failed.
+
+/**
+ * @brief Records a failed check.
+ * @param what Description of the check.
+ * @param index Record, flip or offset it failed at.
+ */
+static void fail(const char* what, size_t index) {
+    if (failures++ < 10) {
+        fprintf(stderr, "event-test: %s (at %zu)\n", what, index);
+    }
+}
+
+/**
+ * @brief Compares two records field by field.
+ * @param a First record.
+ * @param b Second record.
+ * @return True if every field matches.
+ */
+static bool sameEvent(const EventRecord& a, const EventRecord& b) {
+    return a.type == b.type && a.source == b.source && a.detail == b.detail && a.start == b.start &&
+           a.end == b.end;
+}
+
+/**
+ * @brief Feeds a byte sequence to a decoder and collects what it yields.
+ * @param decoder Decoder to feed.
+ * @param bytes Stream bytes.
+ * @param length Number of bytes.
+ * @param events Appended with each decoded event.
+ * @param lines Appended with each text line, if not null.
+ * @return Number of frames rejected while feeding.
+ */
+static uint32_t feed(EventDecoder& decoder, const uint8_t* bytes, size_t length, std::vector<EventRecord>& events,
+                     std::vector<std::string>* lines = nullptr) {
+    uint32_t bad = 0;
+    for (size_t i = 0; i < length; i++) {
+        switch (decoder.feed(bytes[i])) {
+            case DECODE_EVENT:
+                events.push_back(decoder.getEvent());
+                break;
+            case DECODE_TEXT:
+                if (lines) {
+                    lines->push_back(decoder.getText());
+                }
+                break;
+            case DECODE_BAD_FRAME:
+                bad++;
+                break;
+            default:
+                break;
+        }
+    }
+    return bad;
+}
+
+/**
+ * @brief Draws a random timestamp, often small or with zero bytes.
+ * @param rng Random source.
+ * @return Timestamp.
+ */
+static uint64_t randomTimestamp(std::mt19937_64& rng) {
+    uint64_t value = rng();
+    switch (rng() % 4) {
+        case 0:
+            return value & 0xFFFFFFFFULL; // A session's worth of microseconds
+        case 1:
+            return value & 0xFF00FF0000FF00FFULL;
+        case 2:
+            return value % 4;
+        default:
+            return value;
+    }
+}
+
+/**
+ * @brief Draws a random event record.
+ * @param rng Random source.
+ * @return Event record.
+ */
+static EventRecord randomEvent(std::mt19937_64& rng) {
+    EventRecord event;
+    event.type = static_cast<uint8_t>(EVENT_LEVER_PRESS + rng() % EVENT_FRAME);
+    event.source = static_cast<uint8_t>(SOURCE_RH_LEVER + rng() % SOURCE_FRAME);
+    event.detail = static_cast<uint8_t>(rng() % (DETAIL_NO_CONDITION + 1));
+    event.start = randomTimestamp(rng);
+    event.end = randomTimestamp(rng);
+    return event;
+}
+
+int main(int argc, char** argv) {
+    size_t count = 100000;
+    unsigned long seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+            count = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--events N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    std::mt19937_64 rng(seed);
+
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    if (crc16(check, sizeof(check)) != 0x29B1) {
+        fail("crc16() does not match CRC-16/CCITT-FALSE", 0);
+    }
+
+    // Round trip
+    uint8_t bytes[EVENT_FRAME_SIZE];
+    size_t roundTrips = 0;
+    for (size_t i = 0; i < count; i++) {
+        EventRecord event = randomEvent(rng);
+        size_t length = encodeEventFrame(event, bytes);
+        EventDecoder decoder;
+        std::vector<EventRecord> events;
+        if (length > EVENT_FRAME_SIZE || memchr(&bytes[1], 0, length - 2) || feed(decoder, bytes, length, events) ||
+            events.size() != 1 || !sameEvent(events[0], event)) {
+            fail("frame did not round-trip", i);
+        } else {
+            roundTrips++;
+        }
+    }
+
+    // Text lines and frames interleaved
+    {
+        std::vector<uint8_t> stream;
+        std::vector<EventRecord> sent;
+        std::vector<std::string> sentLines;
+        const char* const messages[] = {"LINK", "LH_LEVER,ARMED", "{\"paradigm\":\"FR\",\"ratio\":1}"};
+        for (size_t i = 0; i < 300; i++) {
+            EventRecord event = randomEvent(rng);
+            event.type = static_cast<uint8_t>(EVENT_LEVER_PRESS + i % EVENT_FRAME);
+            event.start = (rng() % 10800000) * 1000;
+            event.end = event.start + (rng() % 1000) * 1000;
+            if (i % 3 == 2) {
+                size_t length = encodeEventFrame(event, bytes);
+                stream.insert(stream.end(), bytes, bytes + length);
+                sent.push_back(event);
+                continue;
+            }
+            char line[64];
+            if (i % 3 == 0) {
+                snprintf(line, sizeof(line), "RH_LEVER,ACTIVE_PRESS,%llu,%llu", static_cast<unsigned long long>(event.start),
+                         static_cast<unsigned long long>(event.end));
+            } else {
+                snprintf(line, sizeof(line), "%s", messages[(i / 3) % 3]);
+            }
+            sentLines.push_back(line);
+            stream.insert(stream.end(), line, line + strlen(line));
+            stream.push_back('\r');
+            stream.push_back('\n');
+        }
+        EventDecoder decoder;
+        std::vector<EventRecord> events;
+        std::vector<std::string> lines;
+        if (feed(decoder, stream.data(), stream.size(), events, &lines) || lines != sentLines ||
+            events.size() != sent.size()) {
+            fail("mixed stream did not split into the lines and frames sent", 0);
+        } else {
+            for (size_t i = 0; i < sent.size(); i++) {
+                if (!sameEvent(events[i], sent[i])) {
+                    fail("mixed stream frame changed", i);
+                }
+            }
+        }
+    }
+
+    // Every single-bit error inside a frame, followed by a good frame
+    size_t rejected = 0;
+    EventRecord next = randomEvent(rng);
+    uint8_t nextFrame[EVENT_FRAME_SIZE];
+    size_t nextLength = encodeEventFrame(next, nextFrame);
+    for (size_t trial = 0; trial < 64; trial++) {
+        EventRecord event = randomEvent(rng);
+        uint8_t frame[EVENT_FRAME_SIZE];
+        size_t length = encodeEventFrame(event, frame);
+        for (size_t position = 1; position + 1 < length; position++) {
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                uint8_t corrupted[EVENT_FRAME_SIZE];
+                memcpy(corrupted, frame, length);
+                corrupted[position] ^= 1 << bit;
+                EventDecoder decoder;
+                std::vector<EventRecord> events;
+                uint32_t bad = feed(decoder, corrupted, length, events);
+                feed(decoder, nextFrame, nextLength, events);
+                if (bad == 0 || events.size() != 1 || !sameEvent(events[0], next)) {
+                    fail("corrupted frame was accepted or the next frame was lost", position * 8 + bit);
+                } else {
+                    rejected++;
+                }
+            }
+        }
+    }
+
+    // Joining mid-frame, and a frame whose closing delimiter was lost
+    size_t resyncs = 0;
+    for (size_t trial = 0; trial < 64; trial++) {
+        uint8_t frames[3][EVENT_FRAME_SIZE];
+        size_t lengths[3];
+        EventRecord events[3];
+        for (size_t i = 0; i < 3; i++) {
+            events[i] = randomEvent(rng);
+            lengths[i] = encodeEventFrame(events[i], frames[i]);
+        }
+        for (size_t offset = 1; offset < lengths[0]; offset++) {
+            EventDecoder decoder;
+            std::vector<EventRecord> decoded;
+            feed(decoder, &frames[0][offset], lengths[0] - offset, decoded);
+            feed(decoder, frames[1], lengths[1], decoded);
+            feed(decoder, frames[2], lengths[2], decoded);
+            if (decoded.size() != 2 || !sameEvent(decoded[0], events[1]) || !sameEvent(decoded[1], events[2])) {
+                fail("frames after a mid-frame start were lost", offset);
+            } else {
+                resyncs++;
+            }
+        }
+        for (size_t cut = 2; cut + 1 < lengths[0]; cut++) { // Cut before the last data byte
+            EventDecoder decoder;
+            std::vector<EventRecord> decoded;
+            feed(decoder, frames[0], cut, decoded);
+            feed(decoder, frames[1], lengths[1], decoded);
+            feed(decoder, frames[2], lengths[2], decoded);
+            if (decoded.size() != 2 || !sameEvent(decoded[0], events[1]) || !sameEvent(decoded[1], events[2]) ||
+                decoder.getBadFrames() != 1) {
+                fail("frames after a truncated frame were lost", cut);
+            } else {
+                resyncs++;
+            }
+        }
+    }
+
+    printf("EVENTS,%zu,%zu,%zu\n", roundTrips, rejected, resyncs);
+    return failures ? 1 : 0;
+}
\ No newline at end of file
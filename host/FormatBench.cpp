@@ -0,0 +1,154 @@
+#include <new>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "HostHAL.h"
+#include "Event_Utils.h"
+
+/*
+  Compares the cost of writing text event lines with Arduino String concatenation,
+  as the sketches originally did, against formatEvent().
+
+  Usage: format-bench [--events N]
+
+  Both paths format the same random lever, infusion, stim, lick and frame events. The
+  benchmark first checks that every line is byte-identical, then prints the time and
+  heap allocations per event for each. Run on an x86 host, the times only show the
+  relative cost; allocations per event carry over to the board unchanged.
+*/
+
+EVENT_FORMAT eventFormat = TEXT_FORMAT; ///< Format used by formatEvent().
+EventQueue eventQueue;                  ///< Required by Event_Utils; unused here.
+
+static uint64_t allocations = 0;        ///< Heap allocations since the program started.
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t size) noexcept {
+    (void)size;
+    free(p);
+}
+
+/**
+ * @brief Builds an event line the way the original sketches did, with String concatenation.
+ * @param event Event; timestamps are whole milliseconds (us values divisible by 1000).
+ * @return Line, including the CR/LF that Serial.println() adds.
+ */
+static String formatWithString(const EventRecord& event) {
+    uint32_t start = static_cast<uint32_t>(event.start / 1000);
+    uint32_t end = static_cast<uint32_t>(event.end / 1000);
+    String entry;
+    switch (event.type) {
+        case EVENT_LEVER_PRESS: {
+            String orientation = event.source == SOURCE_RH_LEVER ? "RH" : "LH";
+            String pressType = event.detail == DETAIL_ACTIVE ? "ACTIVE" : event.detail == DETAIL_TIMEOUT ? "TIMEOUT" : "INACTIVE";
+            entry = orientation + "_LEVER,";
+            entry += pressType + "_PRESS,";
+            entry += String(start) + ",";
+            entry += String(end);
+            break;
+        }
+        case EVENT_INFUSION:
+            entry = "PUMP,INFUSION,";
+            entry += String(start);
+            entry += ",";
+            entry += String(end);
+            break;
+        case EVENT_STIM:
+            entry = "LASER,STIM,";
+            entry += String(start) + "," + String(end);
+            break;
+        case EVENT_LICK:
+            entry = "LICK_CIRCUIT,LICK," + String(start) + "," + String(end);
+            break;
+        default:
+            entry = "FRAME_TIMESTAMP," + String(start);
+            break;
+    }
+    return entry + "\r\n";
+}
+
+/**
+ * @brief Returns the time on the process CPU clock.
+ * @return Time (ns).
+ */
+static uint64_t cpuNanos() {
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+int main(int argc, char** argv) {
+    size_t count = 200000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+            count = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--events N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // A 3-hour session's worth of timestamps, in whole milliseconds like the original log
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<uint32_t> time(0, 3 * 3600 * 1000);
+    std::uniform_int_distribution<uint32_t> length(1, 30000);
+    EventRecord* events = static_cast<EventRecord*>(malloc(count * sizeof(EventRecord)));
+    static const EVENT_TYPE types[] = {EVENT_LEVER_PRESS, EVENT_INFUSION, EVENT_STIM, EVENT_LICK, EVENT_FRAME};
+    static const EVENT_SOURCE sources[] = {SOURCE_RH_LEVER, SOURCE_PUMP, SOURCE_LASER, SOURCE_LICK_CIRCUIT, SOURCE_FRAME};
+    for (size_t i = 0; i < count; i++) {
+        uint8_t kind = rng() % 5;
+        uint32_t start = time(rng);
+        events[i].type = types[kind];
+        events[i].source = kind == 0 && rng() % 2 ? SOURCE_LH_LEVER : sources[kind];
+        events[i].detail = kind == 0 ? static_cast<EVENT_DETAIL>(1 + rng() % 3) : DETAIL_NONE;
+        events[i].start = static_cast<uint64_t>(start) * 1000;
+        events[i].end = static_cast<uint64_t>(start + length(rng)) * 1000;
+    }
+
+    uint8_t line[EVENT_LINE_SIZE];
+    for (size_t i = 0; i < count; i++) {
+        String expected = formatWithString(events[i]);
+        size_t size = formatEvent(events[i], line);
+        if (size != expected.length() || memcmp(line, expected.c_str(), size) != 0) {
+            fprintf(stderr, "MISMATCH,%zu,%s", i, expected.c_str());
+            return 1;
+        }
+    }
+
+    size_t checksum = 0; // Keeps the optimizer from discarding the work
+    uint64_t startAllocations = allocations;
+    uint64_t startTime = cpuNanos();
+    for (size_t i = 0; i < count; i++) {
+        checksum += formatWithString(events[i]).length();
+    }
+    double stringNanos = static_cast<double>(cpuNanos() - startTime) / count;
+    double stringAllocations = static_cast<double>(allocations - startAllocations) / count;
+
+    startAllocations = allocations;
+    startTime = cpuNanos();
+    for (size_t i = 0; i < count; i++) {
+        checksum += formatEvent(events[i], line);
+    }
+    double formatNanos = static_cast<double>(cpuNanos() - startTime) / count;
+    double formatAllocations = static_cast<double>(allocations - startAllocations) / count;
+
+    printf("FORMAT,EVENTS,%zu,IDENTICAL,BYTES,%zu\n", count, checksum / 2);
+    printf("FORMAT,STRING,%.1f ns/event,%.2f allocations/event\n", stringNanos, stringAllocations);
+    printf("FORMAT,FORMATTER,%.1f ns/event,%.2f allocations/event\n", formatNanos, formatAllocations);
+    free(events);
+    return 0;
+}
\ No newline at end of file
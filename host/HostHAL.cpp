@@ -0,0 +1,593 @@
+#include <deque>
+#include <string>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "HostHAL.h"
+
+/**
+ * @struct HostPin
+ * @brief State of one digital pin as seen from inside and outside the board.
+ */
+struct HostPin {
+    uint8_t mode;                    ///< INPUT, OUTPUT or INPUT_PULLUP.
+    uint8_t output;                  ///< Level written by the sketch.
+    bool driven;                     ///< Whether something outside the board drives the pin.
+    uint8_t external;                ///< Level driven from outside the board.
+    unsigned int toneFrequency;      ///< Frequency of the tone playing on the pin (Hz).
+    uint64_t toneEnd;                ///< End of a timed tone (us), or 0 for an untimed one.
+    uint64_t writes;                 ///< digitalWrite()/tone()/noTone() calls on the pin.
+};
+
+/**
+ * @struct HostInterrupt
+ * @brief An ISR attached to an external interrupt.
+ */
+struct HostInterrupt {
+    void (*isr)();                   ///< Service routine, or nullptr.
+    int mode;                        ///< CHANGE, FALLING or RISING.
+};
+
+HardwareSerial Serial;
+
+static HOST_CLOCK clockSource = HOST_REAL_TIME; ///< Source of millis()/micros().
+static timespec realStart = {0, 0};             ///< Wall clock at hostBegin().
+static uint64_t virtualMicros = 0;              ///< Virtual clock (us).
+static HostPin pins[NUM_DIGITAL_PINS];          ///< Pin states.
+static HostInterrupt externalInterrupts[2];     ///< INT0 (pin 2) and INT1 (pin 3).
+static int serialRx = STDIN_FILENO;             ///< Descriptor Serial reads from.
+static int serialTx = STDOUT_FILENO;            ///< Descriptor Serial writes to.
+static std::deque<uint8_t> rxBuffer;            ///< Bytes received but not yet read.
+static std::string txBuffer;                    ///< Bytes written but not yet flushed.
+static void (*serialSink)(const char*, size_t) = nullptr; ///< Receives output instead of serialTx.
+static FILE* traceFile = nullptr;               ///< Open VCD trace, or nullptr.
+static char traceIds[NUM_DIGITAL_PINS];         ///< VCD identifier per traced pin, or 0.
+static uint8_t traceLevels[NUM_DIGITAL_PINS];   ///< Last level written per traced pin.
+static uint64_t traceTime = 0;                  ///< Time of the last timestamp written (ns).
+
+// =======================================================
+// Harness controls
+// =======================================================
+
+void hostBegin(HOST_CLOCK clock) {
+    clockSource = clock;
+    virtualMicros = 0;
+    clock_gettime(CLOCK_MONOTONIC, &realStart);
+    int flags = serialRx >= 0 ? fcntl(serialRx, F_GETFL) : -1;
+    if (flags >= 0) {
+        fcntl(serialRx, F_SETFL, flags | O_NONBLOCK);
+    }
+}
+
+HOST_CLOCK hostClock() {
+    return clockSource;
+}
+
+/**
+ * @brief Returns the time since hostBegin() at the clock's full resolution.
+ * @return Elapsed time (ns).
+ */
+static uint64_t hostNanos() {
+    if (clockSource == HOST_VIRTUAL_TIME) {
+        return virtualMicros * 1000;
+    }
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec - realStart.tv_sec) * 1000000000ULL + now.tv_nsec - realStart.tv_nsec;
+}
+
+uint64_t hostMicros() {
+    return hostNanos() / 1000;
+}
+
+void hostAdvance(uint64_t us) {
+    if (clockSource == HOST_VIRTUAL_TIME) {
+        virtualMicros += us;
+    } else if (us > 0) {
+        timespec duration = {static_cast<time_t>(us / 1000000), static_cast<long>(us % 1000000) * 1000};
+        nanosleep(&duration, nullptr);
+    }
+}
+
+/**
+ * @brief Returns the level a pin reads back, from inside the board.
+ * @param pin Digital pin.
+ * @return HIGH or LOW.
+ */
+static uint8_t pinLevel(const HostPin& pin) {
+    if (pin.mode == OUTPUT) {
+        return pin.output;
+    }
+    if (pin.driven) {
+        return pin.external;
+    }
+    return pin.mode == INPUT_PULLUP ? HIGH : LOW;
+}
+
+/**
+ * @brief Runs the ISR attached to a pin if a level change matches its mode.
+ * @param pin Digital pin.
+ * @param before Level before the change.
+ * @param after Level after the change.
+ */
+static void raiseInterrupt(uint8_t pin, uint8_t before, uint8_t after) {
+    int interruptNum = digitalPinToInterrupt(pin);
+    if (interruptNum == NOT_AN_INTERRUPT || before == after) {
+        return;
+    }
+    const HostInterrupt& interrupt = externalInterrupts[interruptNum];
+    if (interrupt.isr &&
+        (interrupt.mode == CHANGE ||
+         (interrupt.mode == RISING && after == HIGH) ||
+         (interrupt.mode == FALLING && after == LOW))) {
+        interrupt.isr();
+    }
+}
+
+// =======================================================
+// Waveform trace
+// =======================================================
+
+/**
+ * @brief Returns the level a pin shows on the trace, ignoring the expiry of timed tones.
+ * @param pin Digital pin.
+ * @return HIGH or LOW.
+ */
+static uint8_t traceLevel(uint8_t pin) {
+    return pins[pin].toneFrequency ? HIGH : pinLevel(pins[pin]);
+}
+
+/**
+ * @brief Writes a level to the trace if it differs from the last one written for the pin.
+ * @param pin Traced digital pin.
+ * @param level Level.
+ * @param ns Time of the change (ns); never earlier than the last one written.
+ */
+static void traceWrite(uint8_t pin, uint8_t level, uint64_t ns) {
+    if (level == traceLevels[pin]) {
+        return;
+    }
+    if (ns != traceTime) {
+        fprintf(traceFile, "#%llu\n", static_cast<unsigned long long>(ns));
+        traceTime = ns;
+    }
+    fprintf(traceFile, "%c%c\n", level ? '1' : '0', traceIds[pin]);
+    traceLevels[pin] = level;
+}
+
+/**
+ * @brief Writes the ends of timed tones that ran out up to a time, earliest first.
+ *
+ * A timed tone stops without any call into the HAL, so its falling edge is written
+ * late, at the time it was due, before the next change or the end of the trace.
+ *
+ * @param ns Time reached (ns).
+ */
+static void traceToneEnds(uint64_t ns) {
+    for (;;) {
+        int due = -1;
+        for (uint8_t pin = 0; pin < NUM_DIGITAL_PINS; pin++) {
+            const HostPin& state = pins[pin];
+            if (traceIds[pin] && state.toneFrequency && state.toneEnd && state.toneEnd * 1000 <= ns &&
+                (due < 0 || state.toneEnd < pins[due].toneEnd)) {
+                due = pin;
+            }
+        }
+        if (due < 0) {
+            return;
+        }
+        uint64_t end = pins[due].toneEnd * 1000;
+        pins[due].toneFrequency = 0;
+        traceWrite(due, pinLevel(pins[due]), end > traceTime ? end : traceTime);
+    }
+}
+
+/**
+ * @brief Writes any tone ends that are due before a tone's state is changed or cleared.
+ */
+static void traceCatchUp() {
+    if (traceFile) {
+        traceToneEnds(hostNanos());
+    }
+}
+
+/**
+ * @brief Records the current level of a pin if it is traced.
+ * @param pin Digital pin.
+ */
+static void tracePin(uint8_t pin) {
+    if (!traceFile || !traceIds[pin]) {
+        return;
+    }
+    uint64_t now = hostNanos();
+    traceToneEnds(now);
+    traceWrite(pin, traceLevel(pin), now > traceTime ? now : traceTime);
+}
+
+bool hostTraceOpen(const char* path, const HostTracePin* tracePins, size_t count) {
+    hostTraceClose();
+    traceFile = fopen(path, "w");
+    if (!traceFile) {
+        return false;
+    }
+    memset(traceIds, 0, sizeof(traceIds));
+    fprintf(traceFile, "$version REACHER host HAL $end\n$timescale 1ns $end\n$scope module rig $end\n");
+    for (size_t i = 0; i < count; i++) {
+        uint8_t pin = tracePins[i].pin;
+        if (pin < NUM_DIGITAL_PINS && !traceIds[pin]) {
+            traceIds[pin] = static_cast<char>('!' + i); // Printable identifiers, one character each
+            fprintf(traceFile, "$var wire 1 %c %s $end\n", traceIds[pin], tracePins[i].name);
+        }
+    }
+    traceTime = hostNanos();
+    fprintf(traceFile, "$upscope $end\n$enddefinitions $end\n#%llu\n$dumpvars\n",
+            static_cast<unsigned long long>(traceTime));
+    for (uint8_t pin = 0; pin < NUM_DIGITAL_PINS; pin++) {
+        if (traceIds[pin]) {
+            traceLevels[pin] = traceLevel(pin);
+            fprintf(traceFile, "%c%c\n", traceLevels[pin] ? '1' : '0', traceIds[pin]);
+        }
+    }
+    fprintf(traceFile, "$end\n");
+    return true;
+}
+
+void hostTraceClose() {
+    if (!traceFile) {
+        return;
+    }
+    uint64_t now = hostNanos();
+    traceToneEnds(now);
+    if (now > traceTime) {
+        fprintf(traceFile, "#%llu\n", static_cast<unsigned long long>(now));
+    }
+    fclose(traceFile);
+    traceFile = nullptr;
+}
+
+// =======================================================
+// Pins
+// =======================================================
+
+void hostDrivePin(uint8_t pin, uint8_t level) {
+    if (pin >= NUM_DIGITAL_PINS) {
+        return;
+    }
+    uint8_t before = pinLevel(pins[pin]);
+    pins[pin].driven = true;
+    pins[pin].external = level ? HIGH : LOW;
+    tracePin(pin);
+    raiseInterrupt(pin, before, pinLevel(pins[pin]));
+}
+
+void hostReleasePin(uint8_t pin) {
+    if (pin >= NUM_DIGITAL_PINS) {
+        return;
+    }
+    uint8_t before = pinLevel(pins[pin]);
+    pins[pin].driven = false;
+    tracePin(pin);
+    raiseInterrupt(pin, before, pinLevel(pins[pin]));
+}
+
+unsigned int hostToneFrequency(uint8_t pin) {
+    if (pin >= NUM_DIGITAL_PINS) {
+        return 0;
+    }
+    HostPin& state = pins[pin];
+    if (state.toneFrequency && state.toneEnd && hostMicros() >= state.toneEnd) {
+        traceCatchUp();
+        state.toneFrequency = 0; // Timed tone has run out
+    }
+    return state.toneFrequency;
+}
+
+uint64_t hostPinWrites(uint8_t pin) {
+    return pin < NUM_DIGITAL_PINS ? pins[pin].writes : 0;
+}
+
+uint8_t hostPinLevel(uint8_t pin) {
+    if (pin >= NUM_DIGITAL_PINS) {
+        return LOW;
+    }
+    return hostToneFrequency(pin) ? HIGH : pins[pin].output;
+}
+
+void hostSerialAttach(int rxFd, int txFd) {
+    serialRx = rxFd;
+    serialTx = txFd;
+    int flags = serialRx >= 0 ? fcntl(serialRx, F_GETFL) : -1;
+    if (flags >= 0) {
+        fcntl(serialRx, F_SETFL, flags | O_NONBLOCK);
+    }
+}
+
+bool hostSerialOpenPty(char* name, size_t size) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        return false;
+    }
+    const char* slaveName = ptsname(master);
+    if (!slaveName) {
+        return false;
+    }
+    // Keep a slave descriptor open so the port survives the GUI closing it, and make it raw
+    int slave = open(slaveName, O_RDWR | O_NOCTTY);
+    if (slave >= 0) {
+        termios settings;
+        if (tcgetattr(slave, &settings) == 0) {
+            cfmakeraw(&settings);
+            tcsetattr(slave, TCSANOW, &settings);
+        }
+    }
+    snprintf(name, size, "%s", slaveName);
+    hostSerialAttach(master, master);
+    return true;
+}
+
+void hostSerialInject(const char* data, size_t size) {
+    rxBuffer.insert(rxBuffer.end(), data, data + size);
+}
+
+void hostSerialCapture(void (*sink)(const char* data, size_t size)) {
+    serialSink = sink;
+}
+
+void hostSerialFlush() {
+    if (serialSink && !txBuffer.empty()) {
+        serialSink(txBuffer.data(), txBuffer.size());
+        txBuffer.clear();
+        return;
+    }
+    size_t sent = 0;
+    while (sent < txBuffer.size()) {
+        ssize_t n = ::write(serialTx, txBuffer.data() + sent, txBuffer.size() - sent);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            break; // Nobody is listening (e.g., the pty is closed); drop like a USB port would
+        }
+    }
+    txBuffer.clear();
+}
+
+// =======================================================
+// Arduino API
+// =======================================================
+
+unsigned long millis() {
+    return static_cast<uint32_t>(hostMicros() / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<uint32_t>(hostMicros());
+}
+
+void delay(unsigned long ms) {
+    hostSerialFlush();
+    hostAdvance(static_cast<uint64_t>(ms) * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    hostAdvance(us);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < NUM_DIGITAL_PINS) {
+        uint8_t before = pinLevel(pins[pin]);
+        pins[pin].mode = mode;
+        tracePin(pin);
+        raiseInterrupt(pin, before, pinLevel(pins[pin]));
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+    if (pin < NUM_DIGITAL_PINS) {
+        uint8_t before = pinLevel(pins[pin]);
+        pins[pin].output = level ? HIGH : LOW;
+        pins[pin].writes++;
+        tracePin(pin);
+        raiseInterrupt(pin, before, pinLevel(pins[pin]));
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < NUM_DIGITAL_PINS ? pinLevel(pins[pin]) : LOW;
+}
+
+void analogWrite(uint8_t pin, int value) {
+    digitalWrite(pin, value >= 128 ? HIGH : LOW);
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+    if (pin < NUM_DIGITAL_PINS) {
+        traceCatchUp();
+        pins[pin].toneFrequency = frequency;
+        pins[pin].writes++;
+        pins[pin].toneEnd = duration ? hostMicros() + static_cast<uint64_t>(duration) * 1000 : 0;
+        tracePin(pin);
+    }
+}
+
+void noTone(uint8_t pin) {
+    if (pin < NUM_DIGITAL_PINS) {
+        traceCatchUp();
+        pins[pin].toneFrequency = 0;
+        pins[pin].output = LOW;
+        pins[pin].writes++;
+        tracePin(pin);
+    }
+}
+
+void attachInterrupt(uint8_t interruptNum, void (*isr)(), int mode) {
+    if (interruptNum < 2) {
+        externalInterrupts[interruptNum].isr = isr;
+        externalInterrupts[interruptNum].mode = mode;
+    }
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+    if (interruptNum < 2) {
+        externalInterrupts[interruptNum].isr = nullptr;
+    }
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) {
+        srandom(seed);
+    }
+}
+
+long random(long howBig) {
+    return howBig == 0 ? 0 : ::random() % howBig;
+}
+
+long random(long howSmall, long howBig) {
+    return howSmall >= howBig ? howSmall : random(howBig - howSmall) + howSmall;
+}
+
+// =======================================================
+// String, Print and Serial
+// =======================================================
+
+/**
+ * @brief Formats an unsigned value in a base between 2 and 16.
+ * @param value Value to format.
+ * @param base Number base.
+ * @return Digits, most significant first.
+ */
+static std::string formatUnsigned(unsigned long value, int base) {
+    if (base < 2 || base > 16) {
+        base = DEC;
+    }
+    char digits[sizeof(value) * 8 + 1];
+    char* p = digits + sizeof(digits);
+    *--p = '\0';
+    do {
+        *--p = "0123456789ABCDEF"[value % base];
+        value /= base;
+    } while (value);
+    return std::string(p);
+}
+
+/**
+ * @brief Formats a signed value; like Arduino, only base 10 gets a minus sign.
+ * @param value Value to format.
+ * @param base Number base.
+ * @return Formatted value.
+ */
+static std::string formatSigned(long value, int base) {
+    if (base == DEC && value < 0) {
+        return "-" + formatUnsigned(0UL - static_cast<unsigned long>(value), DEC);
+    }
+    return formatUnsigned(static_cast<unsigned long>(value), base);
+}
+
+/**
+ * @brief Formats a floating-point value with a fixed number of decimals.
+ * @param value Value to format.
+ * @param decimalPlaces Digits after the decimal point.
+ * @return Formatted value.
+ */
+static std::string formatDouble(double value, int decimalPlaces) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimalPlaces, value);
+    return std::string(buffer);
+}
+
+String::String(unsigned char value, unsigned char base) : s(formatUnsigned(value, base)) {}
+String::String(int value, unsigned char base) : s(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : s(formatUnsigned(value, base)) {}
+String::String(long value, unsigned char base) : s(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : s(formatUnsigned(value, base)) {}
+String::String(double value, unsigned char decimalPlaces) : s(formatDouble(value, decimalPlaces)) {}
+
+void String::trim() {
+    size_t first = s.find_first_not_of(" \t\r\n\f\v");
+    if (first == std::string::npos) {
+        s.clear();
+        return;
+    }
+    size_t last = s.find_last_not_of(" \t\r\n\f\v");
+    s = s.substr(first, last - first + 1);
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::print(long value, int base) {
+    std::string text = formatSigned(value, base);
+    return write(text.data(), text.size());
+}
+
+size_t Print::print(unsigned long value, int base) {
+    std::string text = formatUnsigned(value, base);
+    return write(text.data(), text.size());
+}
+
+size_t Print::print(double value, int decimalPlaces) {
+    std::string text = formatDouble(value, decimalPlaces);
+    return write(text.data(), text.size());
+}
+
+/**
+ * @brief Moves any bytes waiting on the receive descriptor into the receive buffer.
+ */
+static void pollSerial() {
+    if (serialRx < 0) {
+        return; // Input is injected by the harness
+    }
+    uint8_t buffer[SERIAL_RX_BUFFER_SIZE];
+    ssize_t n;
+    while ((n = ::read(serialRx, buffer, sizeof(buffer))) > 0) {
+        rxBuffer.insert(rxBuffer.end(), buffer, buffer + n);
+    }
+}
+
+int HardwareSerial::available() {
+    pollSerial();
+    return static_cast<int>(rxBuffer.size());
+}
+
+int HardwareSerial::read() {
+    if (rxBuffer.empty()) {
+        pollSerial();
+    }
+    if (rxBuffer.empty()) {
+        return -1;
+    }
+    int c = rxBuffer.front();
+    rxBuffer.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek() {
+    if (rxBuffer.empty()) {
+        pollSerial();
+    }
+    return rxBuffer.empty() ? -1 : rxBuffer.front();
+}
+
+void HardwareSerial::flush() {
+    hostSerialFlush();
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    txBuffer.push_back(static_cast<char>(c));
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    txBuffer.append(reinterpret_cast<const char*>(buffer), size);
+    return size;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <Arduino.h>
+
+/**
+ * @file HostHAL.h
+ * @brief Controls for the host (Linux) Arduino stand-in: clock, pins and serial backing.
+ *
+ * A harness (host/main.cpp, or a simulator) uses these to drive input pins, observe
+ * outputs and advance time between passes of the sketch's loop().
+ */
+
+/**
+ * @enum HOST_CLOCK
+ * @brief Source of millis()/micros() on the host.
+ */
+enum HOST_CLOCK {
+    HOST_REAL_TIME,                  ///< Wall clock (CLOCK_MONOTONIC) since hostBegin().
+    HOST_VIRTUAL_TIME                ///< Advanced only by hostAdvance() and delay().
+};
+
+/**
+ * @brief Selects the clock and restarts it at zero.
+ * @param clock Clock source.
+ */
+void hostBegin(HOST_CLOCK clock);
+
+/**
+ * @brief Returns the clock source selected by hostBegin().
+ */
+HOST_CLOCK hostClock();
+
+/**
+ * @brief Returns the time since hostBegin() without the 32-bit wrap of micros().
+ * @return Elapsed time (us).
+ */
+uint64_t hostMicros();
+
+/**
+ * @brief Moves the clock forward; the real-time clock sleeps instead.
+ * @param us Time to advance (us).
+ */
+void hostAdvance(uint64_t us);
+
+/**
+ * @brief Drives an input pin from outside the board, as a lever, lick circuit or scope would.
+ *
+ * Runs the ISR attached to the pin's external interrupt if the change matches its mode.
+ *
+ * @param pin Digital pin.
+ * @param level HIGH or LOW.
+ */
+void hostDrivePin(uint8_t pin, uint8_t level);
+
+/**
+ * @brief Stops driving a pin, leaving it to its pull-up (if any).
+ * @param pin Digital pin.
+ */
+void hostReleasePin(uint8_t pin);
+
+/**
+ * @brief Returns the level the sketch is driving on an output pin.
+ *
+ * A pin playing a tone reads HIGH until the tone ends.
+ *
+ * @param pin Digital pin.
+ * @return HIGH or LOW.
+ */
+uint8_t hostPinLevel(uint8_t pin);
+
+/**
+ * @brief Returns the frequency of the tone playing on a pin.
+ * @param pin Digital pin.
+ * @return Frequency (Hz), or 0 when silent.
+ */
+unsigned int hostToneFrequency(uint8_t pin);
+
+/**
+ * @brief Returns how many times the sketch has written a pin.
+ *
+ * Counts every digitalWrite(), analogWrite(), tone() and noTone() call on the pin,
+ * whether or not it changed the output.
+ *
+ * @param pin Digital pin.
+ * @return Writes since startup.
+ */
+uint64_t hostPinWrites(uint8_t pin);
+
+/**
+ * @brief Backs Serial with a pair of file descriptors.
+ *
+ * The receive descriptor is switched to non-blocking reads. By default Serial reads
+ * stdin and writes stdout.
+ *
+ * @param rxFd Descriptor Serial reads from, or -1 to receive only hostSerialInject() bytes.
+ * @param txFd Descriptor Serial writes to.
+ */
+void hostSerialAttach(int rxFd, int txFd);
+
+/**
+ * @brief Backs Serial with a new pseudo-terminal that a GUI can open like a USB port.
+ * @param name Buffer receiving the path of the terminal (e.g., "/dev/pts/3").
+ * @param size Size of the buffer.
+ * @return Boolean indicating success.
+ */
+bool hostSerialOpenPty(char* name, size_t size);
+
+/**
+ * @brief Queues bytes as if they had arrived on the serial port.
+ * @param data Bytes to receive.
+ * @param size Number of bytes.
+ */
+void hostSerialInject(const char* data, size_t size);
+
+/**
+ * @brief Hands serial output to a function instead of the transmit descriptor.
+ * @param sink Receives each flushed block of output, or nullptr to write to the descriptor.
+ */
+void hostSerialCapture(void (*sink)(const char* data, size_t size));
+
+/**
+ * @brief Writes buffered serial output to the transmit descriptor (or capture sink).
+ */
+void hostSerialFlush();
+
+/**
+ * @struct HostTracePin
+ * @brief A pin recorded in a waveform trace.
+ */
+struct HostTracePin {
+    uint8_t pin;                     ///< Digital pin.
+    const char* name;                ///< Signal name shown in the viewer (no spaces).
+};
+
+/**
+ * @brief Starts recording pin levels to a Value Change Dump (VCD) file.
+ *
+ * Every change of a listed pin is written with a 1 ns timescale: inputs as driven from
+ * outside the board, outputs as written by the sketch, and a pin playing a tone as
+ * HIGH until the tone ends. On the real-time clock changes carry the nanosecond they
+ * happened at; on the virtual clock, the microsecond they happened in.
+ *
+ * @param path File to write, replacing any existing one.
+ * @param pins Pins to record.
+ * @param count Number of pins.
+ * @return Boolean indicating the file could be created.
+ */
+bool hostTraceOpen(const char* path, const HostTracePin* pins, size_t count);
+
+/**
+ * @brief Ends the trace at the current time and closes its file.
+ */
+void hostTraceClose();
+
+#endif // HOST_HAL_H
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HostHAL.h"
+#include "InputSampler.h"
+#include "Timebase.h"
+
+/*
+  Unit test for InputSampler on the host, where it reads pins with digitalRead().
+
+  Usage: input-sampler-test
+
+  Registers the rig's three inputs (right and left levers, lick circuit) and one spare
+  pin, and checks that:
+  - a fifth pin is refused once MAX_SAMPLED_INPUTS are registered;
+  - every one of the 16 level combinations reads back pin for pin after sample();
+  - read() keeps returning the snapshot while the pins change, until the next sample();
+  - a pin that was never registered is read live;
+  - the snapshot time is the timebase at sample() and holds until the next one;
+  - a PortDebouncer toggles a bit on its fourth differing sample, restarts the count on
+    an agreeing one, and counts each bit of a port independently;
+  - built with -DINPUT_SAMPLER_VERTICAL_DEBOUNCE, edge() reports a press on a held pin
+    once, four debouncer intervals in, and nothing for a shorter glitch.
+  Prints
+    SAMPLER,<checks>,<failures>
+  and exits with 1 on any failure. The AVR port-register path is not built here.
+*/
+
+const byte RH_LEVER_PIN = 10;       ///< Right-hand lever pin, as wired in the sketch.
+const byte LH_LEVER_PIN = 13;       ///< Left-hand lever pin, as wired in the sketch.
+const byte LICK_CIRCUIT_PIN = 5;    ///< Lick circuit pin, as wired in the sketch.
+const byte SPARE_PIN = 12;          ///< Unused rig pin, registered as the fourth input.
+const byte UNREGISTERED_PIN = 11;   ///< Unused rig pin that is never registered.
+
+static uint32_t checks = 0;         ///< Checks run.
+static uint32_t failures = 0;       ///< Checks that failed.
+
+/**
+ * @brief Records one check.
+ * @param passed Whether the check held.
+ * @param what Description of the check.
+ * @param detail Combination, pin or time it was made at.
+ */
+static void expect(bool passed, const char* what, unsigned long long detail) {
+    checks++;
+    if (!passed && failures++ < 10) {
+        fprintf(stderr, "input-sampler-test: %s (at %llu)\n", what, detail);
+    }
+}
+
+/**
+ * @brief Checks the vertical counter on its own.
+ */
+static void checkPortDebouncer() {
+    PortDebouncer debouncer(0xFF);
+    for (uint8_t i = 0; i < 3; i++) {
+        expect(debouncer.update(0xFE) == 0, "bit toggled before the fourth sample", i);
+    }
+    expect(debouncer.update(0xFE) == 0x01, "bit not toggled on the fourth sample", 0xFE);
+    expect(debouncer.getStableBits() == 0xFE, "stable bits not updated", debouncer.getStableBits());
+
+    for (uint8_t i = 0; i < 3; i++) { // Glitch of three samples, then agreement
+        expect(debouncer.update(0xFF) == 0, "glitch toggled a bit", i);
+    }
+    expect(debouncer.update(0xFE) == 0, "agreeing sample toggled a bit", 0xFE);
+    for (uint8_t i = 0; i < 3; i++) {
+        expect(debouncer.update(0xFF) == 0, "count survived an agreeing sample", i);
+    }
+    expect(debouncer.update(0xFF) == 0x01, "bit not toggled back", 0xFF);
+
+    debouncer.reset(0x00); // Bits 0 and 7 start changing two samples apart
+    uint8_t toggled[6];
+    const uint8_t samples[6] = {0x01, 0x01, 0x81, 0x81, 0x81, 0x81};
+    for (uint8_t i = 0; i < 6; i++) {
+        toggled[i] = debouncer.update(samples[i]);
+    }
+    expect(toggled[3] == 0x01 && toggled[5] == 0x80, "bits not counted independently",
+           toggled[3] * 256ULL + toggled[5]);
+    expect(debouncer.getStableBits() == 0x81, "independent bits not stable", debouncer.getStableBits());
+}
+
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+/**
+ * @brief Checks the edges the sampler reports from its port debouncers.
+ * @param sampler Sampler holding the rig's pins, all released.
+ */
+static void checkVerticalEdges(InputSampler& sampler) {
+    for (uint16_t tick = 0; tick < 40; tick++) { // Settle on the released levels
+        hostAdvance(1000);
+        sampler.sample();
+    }
+    uint8_t presses = 0;
+    uint64_t pressedAt = 0;
+    hostDrivePin(RH_LEVER_PIN, LOW);
+    uint64_t heldFrom = hostMicros();
+    for (uint16_t tick = 0; tick < 40; tick++) {
+        hostAdvance(1000);
+        sampler.sample();
+        if (sampler.edge(RH_LEVER_PIN) == EDGE_FALL) {
+            presses++;
+            pressedAt = hostMicros();
+        }
+        expect(sampler.edge(LH_LEVER_PIN) == EDGE_NONE, "edge on an idle pin", tick);
+    }
+    expect(presses == 1, "held pin not reported once", presses);
+    expect(pressedAt - heldFrom > 3 * VERTICAL_DEBOUNCE_INTERVAL &&
+           pressedAt - heldFrom <= 4 * VERTICAL_DEBOUNCE_INTERVAL + 1000,
+           "press not reported four intervals in", pressedAt - heldFrom);
+
+    hostDrivePin(LH_LEVER_PIN, LOW); // Shorter than three intervals
+    for (uint16_t tick = 0; tick < 2 * VERTICAL_DEBOUNCE_INTERVAL / 1000; tick++) {
+        hostAdvance(1000);
+        sampler.sample();
+        expect(sampler.edge(LH_LEVER_PIN) == EDGE_NONE, "glitch reported as an edge", tick);
+    }
+    hostReleasePin(LH_LEVER_PIN);
+    hostReleasePin(RH_LEVER_PIN);
+    uint8_t releases = 0;
+    for (uint16_t tick = 0; tick < 40; tick++) {
+        hostAdvance(1000);
+        sampler.sample();
+        releases += sampler.edge(RH_LEVER_PIN) == EDGE_RISE;
+        expect(sampler.edge(LH_LEVER_PIN) == EDGE_NONE, "glitch reported after release", tick);
+    }
+    expect(releases == 1, "release not reported once", releases);
+}
+#endif
+
+int main() {
+    hostBegin(HOST_VIRTUAL_TIME);
+    timebaseBegin(nullptr);
+    const byte pins[MAX_SAMPLED_INPUTS] = {RH_LEVER_PIN, LH_LEVER_PIN, LICK_CIRCUIT_PIN, SPARE_PIN};
+    InputSampler sampler;
+    for (uint8_t i = 0; i < MAX_SAMPLED_INPUTS; i++) {
+        pinMode(pins[i], INPUT_PULLUP);
+        expect(sampler.addInput(pins[i]), "pin refused before the sampler was full", pins[i]);
+    }
+    pinMode(UNREGISTERED_PIN, INPUT_PULLUP);
+    expect(!sampler.addInput(UNREGISTERED_PIN), "pin accepted past MAX_SAMPLED_INPUTS", UNREGISTERED_PIN);
+
+    for (uint8_t combination = 0; combination < (1 << MAX_SAMPLED_INPUTS); combination++) {
+        for (uint8_t i = 0; i < MAX_SAMPLED_INPUTS; i++) {
+            hostDrivePin(pins[i], (combination >> i) & 1 ? HIGH : LOW);
+        }
+        hostAdvance(1000);
+        sampler.sample();
+        uint64_t sampledAt = hostMicros();
+        for (uint8_t i = 0; i < MAX_SAMPLED_INPUTS; i++) {
+            expect(sampler.read(pins[i]) == ((combination >> i) & 1 ? HIGH : LOW), "level differs from the pin",
+                   combination * 100ULL + pins[i]);
+        }
+
+        for (uint8_t i = 0; i < MAX_SAMPLED_INPUTS; i++) { // Invert every pin without sampling
+            hostDrivePin(pins[i], (combination >> i) & 1 ? LOW : HIGH);
+        }
+        hostAdvance(250);
+        for (uint8_t i = 0; i < MAX_SAMPLED_INPUTS; i++) {
+            expect(sampler.read(pins[i]) == ((combination >> i) & 1 ? HIGH : LOW), "snapshot followed the pin",
+                   combination * 100ULL + pins[i]);
+        }
+        expect(sampler.getTimestamp() == sampledAt, "snapshot time moved without a sample", sampledAt);
+
+        uint8_t level = combination & 1 ? HIGH : LOW;
+        hostDrivePin(UNREGISTERED_PIN, level);
+        expect(sampler.read(UNREGISTERED_PIN) == level, "unregistered pin not read live", combination);
+    }
+
+    hostReleasePin(UNREGISTERED_PIN);
+    for (uint8_t i = 0; i < MAX_SAMPLED_INPUTS; i++) {
+        hostReleasePin(pins[i]);
+    }
+    hostAdvance(1000);
+    sampler.sample();
+    expect(sampler.getTimestamp() == hostMicros() && sampler.getTimestamp() == timebaseMicros(),
+           "snapshot time is not the timebase at sample()", hostMicros());
+    for (uint8_t i = 0; i < MAX_SAMPLED_INPUTS; i++) {
+        expect(sampler.read(pins[i]) == HIGH, "released pin not pulled up", pins[i]);
+    }
+
+    checkPortDebouncer();
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+    checkVerticalEdges(sampler);
+#endif
+
+    printf("SAMPLER,%u,%u\n", checks, failures);
+    return failures ? 1 : 0;
+}
\ No newline at end of file
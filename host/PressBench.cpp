@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "HostHAL.h"
+#include "Session.h"
+#include "Lever_Utils.h"
+
+/*
+  Measures what one active-lever pass of the input task (managePump() and
+  monitorPressing()) costs while the rig is idle, while the cue sounds and while the
+  pump infuses.
+
+  Usage: press-bench [--calls N]
+
+  Links a paradigm sketch for its schedule hooks, runs its setup(), arms the
+  right-hand lever, cue and pump, and runs the pass N times in each phase
+  with the clock held still. Prints the CPU time per call and the pin writes
+  (digitalWrite(), tone(), noTone()) per call on the cue and pump pins. On an x86
+  host the times only show the relative cost; the writes per call carry over to the
+  board, where each tone() reprograms Timer2.
+*/
+
+void setup();
+
+/**
+ * @brief Discards the sketch's serial output.
+ * @param data Output bytes.
+ * @param size Number of bytes.
+ */
+static void discard(const char* data, size_t size) {
+    (void)data;
+    (void)size;
+}
+
+/**
+ * @brief Returns the time on the process CPU clock.
+ * @return Time (ns).
+ */
+static uint64_t cpuNanos() {
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * @brief Returns the writes so far on the cue and pump pins.
+ * @return Writes since startup.
+ */
+static uint64_t actuatorWrites() {
+    return hostPinWrites(CS_PIN) + hostPinWrites(PUMP_PIN);
+}
+
+/**
+ * @brief Times the active-lever pass in the current phase and prints one result line.
+ * @param phase Phase name.
+ * @param calls Calls to time.
+ */
+static void measure(const char* phase, size_t calls) {
+    managePump(&pump); // Settle into the phase
+    monitorPressing(true, activeLever, &cs, &pump, &laser);
+    uint64_t startWrites = actuatorWrites();
+    uint64_t startTime = cpuNanos();
+    for (size_t i = 0; i < calls; i++) {
+        managePump(&pump);
+        monitorPressing(true, activeLever, &cs, &pump, &laser);
+    }
+    double nanos = static_cast<double>(cpuNanos() - startTime) / calls;
+    double writes = static_cast<double>(actuatorWrites() - startWrites) / calls;
+    printf("PRESS,%s,%.1f ns/call,%.2f writes/call\n", phase, nanos, writes);
+}
+
+int main(int argc, char** argv) {
+    size_t calls = 1000000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--calls") == 0 && i + 1 < argc) {
+            calls = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--calls N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    hostBegin(HOST_VIRTUAL_TIME);
+    hostSerialCapture(discard);
+    setup();
+    leverRH.arm();
+    cs.arm();
+    pump.arm();
+    hostAdvance(10000000); // 10 s in, so the idle windows below lie in the past
+
+    int32_t now = static_cast<int32_t>(millis());
+    cs.setOnTimestamp(1000);
+    cs.setOffTimestamp(1000);
+    pump.setInfusionPeriod(cs.getOffTimestamp(), 0);
+    measure("IDLE", calls);
+
+    cs.setOnTimestamp(now);
+    cs.setOffTimestamp(now);
+    pump.setInfusionPeriod(cs.getOffTimestamp(), 0);
+    measure("CUE", calls);
+
+    cs.setOnTimestamp(1000);
+    cs.setOffTimestamp(1000);
+    pump.setInfusionPeriod(now, 0);
+    measure("INFUSION", calls);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HostHAL.h"
+#include "PulseTrain.h"
+#include "Timebase.h"
+
+/*
+  Lengthens a running pulse train past the longest train the engine can time.
+
+  Usage: pulse-train-test [--minutes N]
+
+  Each case starts a one-minute train, as ACTIVE_PRESS stimulation does, and adds a
+  minute of pulses with pulseTrainExtend() half-way through every minute, as repeated
+  rewards do, for N minutes (default 150). That is past the 2^32-tick limit of one train (about 71.6
+  minutes on the host's microsecond clock). The clock steps a millisecond at a time
+  and the pin is sampled after each pulseTrainUpdate(). Two cases run:
+  - PULSES: 10 Hz, 20 ms pulses. Every pulse must appear on the pin.
+  - UNBROKEN: gapless 1 kHz pulses (constant stimulation). The pin must rise once and
+    stay high to the end.
+  In both, every queued train must last at most 2^32 ticks. Each must start one pulse
+  period after the previous train's last pulse started, so the pulses keep their period
+  across trains. The trains together must span every pulse added. Prints
+    PULSETRAIN,<case>,<pulses>,<rising edges>,<trains>,<longest train us>
+  per case and exits with 1 on any failure.
+*/
+
+static uint32_t failures = 0; ///< Checks that failed.
+
+/**
+ * @brief Records one check.
+ * @param passed Whether the check held.
+ * @param name Case name.
+ * @param what Description of the check.
+ * @param detail Value it was made at.
+ */
+static void expect(bool passed, const char* name, const char* what, unsigned long long detail) {
+    if (!passed && failures++ < 10) {
+        fprintf(stderr, "pulse-train-test: %s: %s (%llu)\n", name, what, detail);
+    }
+}
+
+/**
+ * @brief Runs one case.
+ * @param name Case name.
+ * @param frequency Pulses per second (Hz).
+ * @param width Pulse width (us).
+ * @param minutes Minutes of pulses to play.
+ */
+static void runCase(const char* name, uint32_t frequency, uint32_t width, uint32_t minutes) {
+    const uint64_t LIMIT = 0xFFFFFFFFULL; // Longest train (ticks, here us)
+    const uint32_t period = 1000000 / frequency;
+    const uint32_t perMinute = frequency * 60;
+    Waveform waveform = {frequency, width, perMinute, 0, 1, 0, 1, RAMP_NONE, 0}; // One burst, one train
+    if (!pulseTrainStart(waveform)) {
+        expect(false, name, "waveform rejected", frequency);
+        return;
+    }
+    uint64_t pulses = perMinute;
+    uint64_t rises = 0;
+    uint32_t trains = 0;
+    uint64_t longest = 0;
+    uint64_t firstStart = 0;
+    uint64_t lastStart = 0;
+    uint64_t lastEnd = 0;
+    uint8_t level = LOW;
+    for (uint32_t ms = 1; pulseTrainRunning(); ms++) {
+        hostAdvance(1000);
+        if (ms % 60000 == 30000 && ms / 60000 < minutes) { // A reward each minute, while the train still runs
+            pulseTrainExtend(perMinute);
+            pulses += perMinute;
+        }
+        pulseTrainUpdate();
+        uint8_t now = hostPinLevel(PULSE_TRAIN_PIN);
+        rises += now == HIGH && level == LOW;
+        level = now;
+        uint64_t start, end;
+        while (pulseTrainNextTrain(start, end)) {
+            expect(end - start <= LIMIT, name, "train longer than 2^32 ticks", end - start);
+            if (trains == 0) {
+                firstStart = start;
+            } else {
+                // The last pulse of the previous train started (end - width) before its end
+                expect(start == lastEnd - width + period, name, "train does not keep the pulse period", start);
+            }
+            longest = end - start > longest ? end - start : longest;
+            lastStart = start;
+            lastEnd = end;
+            trains++;
+        }
+    }
+    expect(level == LOW, name, "pin left high", level);
+    expect(lastEnd - firstStart == (pulses - 1) * period + width, name, "trains do not span every pulse",
+           lastEnd - firstStart);
+    expect(lastStart > firstStart + LIMIT / 2, name, "no train after the limit", trains);
+    if (width < period) {
+        expect(rises == pulses, name, "pulses missing from the pin", rises);
+    } else {
+        expect(rises == 1, name, "unbroken output went low", rises);
+    }
+    printf("PULSETRAIN,%s,%llu,%llu,%u,%llu\n", name, static_cast<unsigned long long>(pulses),
+           static_cast<unsigned long long>(rises), trains, static_cast<unsigned long long>(longest));
+}
+
+int main(int argc, char** argv) {
+    uint32_t minutes = 150;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--minutes") == 0 && i + 1 < argc) {
+            minutes = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--minutes N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    hostBegin(HOST_VIRTUAL_TIME);
+    timebaseBegin(nullptr);
+    pinMode(PULSE_TRAIN_PIN, OUTPUT);
+    pulseTrainBegin();
+    runCase("PULSES", 10, 20000, minutes);
+    runCase("UNBROKEN", 1000, 1000, minutes);
+    return failures ? 1 : 0;
+}
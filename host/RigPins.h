@@ -0,0 +1,28 @@
+#ifndef RIG_PINS_H
+#define RIG_PINS_H
+
+#include "HostHAL.h"
+#include "Session.h"
+
+/**
+ * @file RigPins.h
+ * @brief Pins of the operant rig that the host harnesses record with --vcd.
+ */
+
+/**
+ * @brief Every device pin plus the imaging and frame timestamp triggers.
+ */
+static const HostTracePin RIG_PINS[] = {
+    {RH_LEVER_PIN, "RH_LEVER"},
+    {LH_LEVER_PIN, "LH_LEVER"},
+    {CS_PIN, "CS"},
+    {PUMP_PIN, "PUMP"},
+    {LICK_CIRCUIT_PIN, "LICK_CIRCUIT"},
+    {LASER_PIN, "LASER"},
+    {IMAGING_TRIGGER, "IMAGING_TRIGGER"},
+    {TIMESTAMP_TRIGGER, "TIMESTAMP_TRIGGER"}
+};
+
+static const size_t RIG_PIN_COUNT = sizeof(RIG_PINS) / sizeof(RIG_PINS[0]); ///< Entries in RIG_PINS.
+
+#endif // RIG_PINS_H
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include "RingBuffer.h"
+
+/*
+  Checks the SPSC ring buffer with its producer running as an interrupt.
+
+  Usage: ring-test [--seconds S] [--period-us P]
+
+  A profiling timer raises SIGPROF every P us of CPU time (default 1000; the kernel
+  rounds it up to its tick) on the thread that consumes, so the handler preempts the
+  consumer at arbitrary instructions, inside pop() or between calls, as the frame ISR
+  preempts loop() on the board. Each signal pushes one to three items numbered in
+  sequence into a 16-slot RingBuffer, the size of the event queue. The consumer pops in a
+  tight loop for 50 ms, then stalls for 100 ms so the queue fills and drops, and so on
+  for S seconds of CPU time (default 2).
+
+  Checks that items come out in order, that each arrives intact (its timestamp is
+  derived from its number) and that produced = consumed + dropped once the queue is
+  drained, so every gap in the numbering is a counted drop. Prints
+    RING,<produced>,<consumed>,<dropped>,<max queued>
+  and exits with 1 on any failure.
+*/
+
+/**
+ * @struct Item
+ * @brief A numbered item, as large as an event record.
+ */
+struct Item {
+    uint64_t timestamp;                      ///< Derived from index by stamp().
+    uint32_t index;                          ///< Position in the produced sequence.
+};
+
+static RingBuffer<Item, 16> queue;           ///< Queue under test.
+static volatile uint32_t produced = 0;       ///< Items offered by the handler.
+static volatile uint32_t nextBurst = 1;      ///< Items the next signal pushes (1-3).
+
+/**
+ * @brief Derives an item's timestamp from its number, so torn copies show up.
+ * @param index Item number.
+ * @return Timestamp stored with the item.
+ */
+static uint64_t stamp(uint32_t index) {
+    return (static_cast<uint64_t>(index) << 32) ^ (index * 2654435761u);
+}
+
+/**
+ * @brief Producer, run as the "interrupt": pushes a short burst of numbered items.
+ * @param signal Unused.
+ */
+static void produce(int signal) {
+    (void)signal;
+    for (uint32_t i = 0; i < nextBurst; i++) {
+        Item item = {stamp(produced), produced};
+        queue.push(item);
+        produced = produced + 1;
+    }
+    nextBurst = nextBurst % 3 + 1;
+}
+
+/**
+ * @brief Returns the time on the process CPU clock.
+ * @return Time (ns).
+ */
+static uint64_t cpuNanos() {
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * @brief Checks one popped item against the one expected next.
+ * @param item Popped item.
+ * @param expected Lowest number the item may carry; advanced past the item.
+ * @return True if the item is intact and in order.
+ */
+static bool check(const Item& item, uint32_t& expected) {
+    if (item.index < expected || item.timestamp != stamp(item.index)) {
+        fprintf(stderr, "ring-test: item %u out of order or torn (expected %u)\n", item.index, expected);
+        return false;
+    }
+    expected = item.index + 1;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    double seconds = 2;
+    long periodMicros = 1000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--period-us") == 0 && i + 1 < argc) {
+            periodMicros = atol(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S] [--period-us P]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = produce;
+    sigaction(SIGPROF, &action, nullptr);
+    itimerval timer = {{periodMicros / 1000000, periodMicros % 1000000}, {periodMicros / 1000000, periodMicros % 1000000}};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+
+    uint32_t expected = 0;
+    uint32_t consumed = 0;
+    uint8_t maxQueued = 0;
+    bool ok = true;
+    uint64_t end = cpuNanos() + static_cast<uint64_t>(seconds * 1e9);
+    uint64_t stallAt = cpuNanos() + 50000000ULL;
+    while (ok && cpuNanos() < end) {
+        uint8_t queued = queue.count();
+        maxQueued = queued > maxQueued ? queued : maxQueued;
+        Item item;
+        while (ok && queue.pop(item)) {
+            ok = check(item, expected);
+            consumed++;
+        }
+        if (cpuNanos() >= stallAt) { // Stall so the queue fills
+            while (cpuNanos() < stallAt + 100000000ULL) {
+            }
+            stallAt = cpuNanos() + 50000000ULL;
+        }
+    }
+
+    timer = {{0, 0}, {0, 0}};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    Item item;
+    while (ok && queue.pop(item)) {
+        ok = check(item, expected);
+        consumed++;
+    }
+    uint16_t dropped = queue.getDropped();
+    if (ok && static_cast<uint16_t>(produced - consumed) != dropped) {
+        fprintf(stderr, "ring-test: %u produced, %u consumed, but %u counted as dropped\n",
+                static_cast<uint32_t>(produced), consumed, dropped);
+        ok = false;
+    }
+    if (ok && (dropped == 0 || maxQueued < 8)) {
+        fprintf(stderr, "ring-test: the producer never filled the queue; raise --seconds\n");
+        ok = false;
+    }
+    printf("RING,%u,%u,%u,%u\n", static_cast<uint32_t>(produced), consumed, dropped, maxQueued);
+    return ok ? 0 : 1;
+}
\ No newline at end of file
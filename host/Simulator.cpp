@@ -0,0 +1,461 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "HostHAL.h"
+#include "RigPins.h"
+#include "Session.h"
+
+/*
+  Runs a paradigm sketch through a scripted session on a virtual clock.
+
+  Usage: <sketch>-sim <scenario> [--output FILE] [--seed N] [--vcd FILE]
+
+  Virtual time jumps straight to the next scheduler tick (1 ms), input edge or
+  scripted command, so a 3-hour session finishes in seconds. The sketch's serial
+  output is written to FILE (default stdout) and a count of each event type is
+  printed to stderr. With --vcd, every rig pin is recorded to a VCD waveform file.
+
+  Scenario format, one directive per line (times in seconds, '#' starts a comment):
+  - duration S                                       session length
+  - seed N                                           random seed (default 1)
+  - at S COMMAND                                     send a serial command at time S
+  - presses RH|LH poisson rate=HZ [hold=S]           presses at exponentially distributed intervals
+  - presses RH|LH bursts rate=HZ size=N ipi=S [hold=S]  bouts of N presses, ipi apart
+  - presses RH|LH periodic hz=HZ [hold=S]            presses at a fixed rate, the first at start
+  - licks rate=HZ hz=LO-HI length=N [contact=S]      lick trains of N licks at LO-HI Hz
+  - frames hz=HZ [width=S]                           imaging frame pulses on the timestamp trigger
+  Every behaviour also takes start=S and stop=S (default: the whole session).
+*/
+
+/**
+ * @enum BEHAVIOUR
+ * @brief Pattern of edges a scripted behaviour produces.
+ */
+enum BEHAVIOUR {
+    POISSON,                         ///< Single contacts at exponentially distributed intervals.
+    BURSTS,                          ///< Bouts of contacts at a fixed inter-contact interval.
+    TRAINS,                          ///< Bouts of contacts at a rate drawn per bout.
+    PERIODIC                         ///< Contacts at a fixed rate (frame pulses, paced presses).
+};
+
+/**
+ * @struct Behaviour
+ * @brief A scripted input and the next edge it will produce.
+ */
+struct Behaviour {
+    BEHAVIOUR kind;                  ///< Edge pattern.
+    uint8_t pin;                     ///< Input pin driven.
+    uint8_t activeLevel;             ///< Level while in contact (LOW for levers).
+    double rate;                     ///< Contacts or bouts per second.
+    double hold;                     ///< Contact length (s).
+    double interval;                 ///< Onset-to-onset interval within a bout (s).
+    double hzLow;                    ///< Lowest rate within a train (Hz).
+    double hzHigh;                   ///< Highest rate within a train (Hz).
+    uint32_t size;                   ///< Contacts per bout.
+    double start;                    ///< Time the behaviour starts (s).
+    double stop;                     ///< Time the behaviour stops (s).
+
+    double onset;                    ///< Onset of the current or next contact (s).
+    double nextEdge;                 ///< Time of the next edge (s).
+    bool contact;                    ///< Whether the next edge starts a contact.
+    uint32_t remaining;              ///< Contacts left in the current bout.
+    uint64_t count;                  ///< Contacts started so far.
+};
+
+/**
+ * @struct ScriptedCommand
+ * @brief A serial command sent at a fixed time.
+ */
+struct ScriptedCommand {
+    double time;                     ///< Time to send (s).
+    std::string text;                ///< Command, without the newline.
+};
+
+static std::mt19937 rng(1);                       ///< Source of behavioural randomness.
+static std::vector<Behaviour> behaviours;         ///< Scripted inputs.
+static std::vector<ScriptedCommand> commands;     ///< Scripted serial commands, in time order.
+static double sessionLength = 0;                  ///< Session length (s).
+static FILE* output = stdout;                     ///< Destination of the sketch's serial output.
+static std::string partialLine;                   ///< Output after the last complete line.
+static std::map<std::string, uint64_t> eventCounts; ///< Output lines per "SOURCE,EVENT" key.
+
+/**
+ * @brief Converts seconds on the session clock to virtual microseconds.
+ * @param seconds Time (s).
+ * @return Time (us).
+ */
+static uint64_t toMicros(double seconds) {
+    return static_cast<uint64_t>(seconds * 1e6 + 0.5);
+}
+
+/**
+ * @brief Draws an exponentially distributed interval.
+ * @param rate Events per second.
+ * @return Interval (s), or effectively forever for a zero rate.
+ */
+static double exponential(double rate) {
+    if (rate <= 0) {
+        return 1e18;
+    }
+    return std::exponential_distribution<double>(rate)(rng);
+}
+
+/**
+ * @brief Draws the onset of the first contact of a new bout.
+ * @param b Behaviour.
+ * @param after Earliest time (s).
+ */
+static void startBout(Behaviour& b, double after) {
+    b.onset = after + exponential(b.rate);
+    b.remaining = b.size;
+    if (b.kind == TRAINS) {
+        b.interval = 1.0 / std::uniform_real_distribution<double>(b.hzLow, b.hzHigh)(rng);
+    }
+}
+
+/**
+ * @brief Works out the edge that follows the one just applied.
+ * @param b Behaviour.
+ */
+static void scheduleNextEdge(Behaviour& b) {
+    if (b.contact) { // Contact just started; it ends after the hold time
+        b.contact = false;
+        b.nextEdge = b.onset + b.hold;
+        return;
+    }
+    double released = b.nextEdge;
+    switch (b.kind) {
+        case POISSON:
+            b.onset = released + exponential(b.rate);
+            break;
+        case BURSTS:
+        case TRAINS:
+            if (--b.remaining > 0) {
+                b.onset += b.interval * std::uniform_real_distribution<double>(0.9, 1.1)(rng);
+            } else {
+                startBout(b, released);
+            }
+            break;
+        case PERIODIC:
+            b.onset = b.start + static_cast<double>(b.count) / b.rate;
+            break;
+    }
+    if (b.onset <= released) {
+        b.onset = released + 0.001; // Contacts never overlap
+    }
+    b.contact = true;
+    b.nextEdge = b.onset;
+}
+
+/**
+ * @brief Checks if a behaviour has an edge left; a contact under way is always released.
+ * @param b Behaviour.
+ * @return Boolean indicating a pending edge.
+ */
+static bool hasPendingEdge(const Behaviour& b) {
+    return !b.contact || b.nextEdge < b.stop;
+}
+
+/**
+ * @brief Drives the pin for the edge that is due and schedules the next one.
+ * @param b Behaviour.
+ */
+static void applyEdge(Behaviour& b) {
+    if (b.contact) {
+        hostDrivePin(b.pin, b.activeLevel);
+        b.count++;
+    } else {
+        hostReleasePin(b.pin);
+    }
+    scheduleNextEdge(b);
+}
+
+/**
+ * @brief Reads a "key=value" parameter from a directive.
+ * @param tokens Directive tokens.
+ * @param key Parameter name.
+ * @param fallback Value used when the parameter is absent.
+ * @return Parameter value.
+ */
+static double param(const std::vector<std::string>& tokens, const char* key, double fallback) {
+    size_t keyLength = strlen(key);
+    for (const std::string& token : tokens) {
+        if (token.compare(0, keyLength, key) == 0 && token.size() > keyLength && token[keyLength] == '=') {
+            return atof(token.c_str() + keyLength + 1);
+        }
+    }
+    return fallback;
+}
+
+/**
+ * @brief Reads a "key=LO-HI" range parameter from a directive.
+ * @param tokens Directive tokens.
+ * @param key Parameter name.
+ * @param low Receives the low end.
+ * @param high Receives the high end.
+ */
+static void rangeParam(const std::vector<std::string>& tokens, const char* key, double& low, double& high) {
+    size_t keyLength = strlen(key);
+    for (const std::string& token : tokens) {
+        if (token.compare(0, keyLength, key) == 0 && token.size() > keyLength && token[keyLength] == '=') {
+            const char* text = token.c_str() + keyLength + 1;
+            char* end;
+            low = strtod(text, &end);
+            high = *end == '-' ? strtod(end + 1, nullptr) : low;
+        }
+    }
+}
+
+/**
+ * @brief Creates a behaviour with the parameters shared by every kind.
+ * @param kind Edge pattern.
+ * @param pin Input pin driven.
+ * @param activeLevel Level while in contact.
+ * @param tokens Directive tokens.
+ * @return Behaviour, not yet scheduled.
+ */
+static Behaviour makeBehaviour(BEHAVIOUR kind, uint8_t pin, uint8_t activeLevel, const std::vector<std::string>& tokens) {
+    Behaviour b = {};
+    b.kind = kind;
+    b.pin = pin;
+    b.activeLevel = activeLevel;
+    b.rate = param(tokens, "rate", 0);
+    b.start = param(tokens, "start", 0);
+    b.stop = param(tokens, "stop", 1e18);
+    return b;
+}
+
+/**
+ * @brief Parses a scenario file.
+ * @param path Scenario path.
+ * @return Boolean indicating success; errors are reported on stderr.
+ */
+static bool loadScenario(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+    char line[256];
+    int lineNumber = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        char* comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        std::vector<std::string> tokens;
+        for (char* token = strtok(line, " \t\r\n"); token; token = strtok(nullptr, " \t\r\n")) {
+            tokens.push_back(token);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+        const std::string& directive = tokens[0];
+        if (directive == "duration" && tokens.size() == 2) {
+            sessionLength = atof(tokens[1].c_str());
+        } else if (directive == "seed" && tokens.size() == 2) {
+            rng.seed(strtoul(tokens[1].c_str(), nullptr, 10));
+        } else if (directive == "at" && tokens.size() >= 3) {
+            ScriptedCommand command = {atof(tokens[1].c_str()), tokens[2]};
+            for (size_t i = 3; i < tokens.size(); i++) {
+                command.text += " " + tokens[i];
+            }
+            commands.push_back(command);
+        } else if (directive == "presses" && tokens.size() >= 3 && (tokens[1] == "RH" || tokens[1] == "LH")) {
+            uint8_t pin = tokens[1] == "RH" ? RH_LEVER_PIN : LH_LEVER_PIN;
+            if (tokens[2] == "poisson") {
+                Behaviour b = makeBehaviour(POISSON, pin, LOW, tokens);
+                b.hold = param(tokens, "hold", 0.15);
+                behaviours.push_back(b);
+            } else if (tokens[2] == "periodic") {
+                Behaviour b = makeBehaviour(PERIODIC, pin, LOW, tokens);
+                b.rate = param(tokens, "hz", 1);
+                b.hold = param(tokens, "hold", 0.15);
+                behaviours.push_back(b);
+            } else if (tokens[2] == "bursts") {
+                Behaviour b = makeBehaviour(BURSTS, pin, LOW, tokens);
+                b.hold = param(tokens, "hold", 0.15);
+                b.size = static_cast<uint32_t>(param(tokens, "size", 3));
+                b.size = b.size ? b.size : 1;
+                b.interval = param(tokens, "ipi", 0.5);
+                behaviours.push_back(b);
+            } else {
+                ok = false;
+            }
+        } else if (directive == "licks") {
+            Behaviour b = makeBehaviour(TRAINS, LICK_CIRCUIT_PIN, HIGH, tokens);
+            b.hold = param(tokens, "contact", 0.04);
+            b.size = static_cast<uint32_t>(param(tokens, "length", 20));
+            b.size = b.size ? b.size : 1;
+            b.hzLow = 6;
+            b.hzHigh = 8;
+            rangeParam(tokens, "hz", b.hzLow, b.hzHigh);
+            behaviours.push_back(b);
+        } else if (directive == "frames") {
+            Behaviour b = makeBehaviour(PERIODIC, TIMESTAMP_TRIGGER, HIGH, tokens);
+            b.rate = param(tokens, "hz", 30);
+            b.hold = param(tokens, "width", 0.001);
+            behaviours.push_back(b);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            fprintf(stderr, "%s:%d: cannot parse \"%s\"\n", path, lineNumber, directive.c_str());
+            break;
+        }
+    }
+    fclose(file);
+    std::stable_sort(commands.begin(), commands.end(), [](const ScriptedCommand& a, const ScriptedCommand& b) {
+        return a.time < b.time; // Same-time commands keep their order
+    });
+    return ok;
+}
+
+/**
+ * @brief Receives the sketch's serial output, writes it out and counts events.
+ *
+ * Lines with comma-separated fields are counted by their leading non-numeric fields
+ * (e.g., "RH_LEVER,ACTIVE_PRESS" or "FRAME_TIMESTAMP").
+ *
+ * @param data Output bytes.
+ * @param size Number of bytes.
+ */
+static void captureOutput(const char* data, size_t size) {
+    fwrite(data, 1, size, output);
+    partialLine.append(data, size);
+    size_t start = 0;
+    size_t end;
+    while ((end = partialLine.find('\n', start)) != std::string::npos) {
+        size_t keyEnd = partialLine.find(',', start);
+        if (keyEnd < end && isupper(static_cast<unsigned char>(partialLine[start]))) { // Skips the setup JSON
+            size_t field = keyEnd + 1;
+            while (field < end && !isdigit(static_cast<unsigned char>(partialLine[field])) && partialLine[field] != '-') {
+                size_t comma = partialLine.find(',', field);
+                keyEnd = comma < end ? comma : end;
+                field = keyEnd + 1;
+            }
+            while (keyEnd > start && partialLine[keyEnd - 1] == '\r') {
+                keyEnd--;
+            }
+            eventCounts[partialLine.substr(start, keyEnd - start)]++;
+        }
+        start = end + 1;
+    }
+    partialLine.erase(0, start);
+}
+
+int main(int argc, char** argv) {
+    const char* scenario = nullptr;
+    const char* outputPath = nullptr;
+    const char* vcdPath = nullptr;
+    long seed = -1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtol(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--vcd") == 0 && i + 1 < argc) {
+            vcdPath = argv[++i];
+        } else if (!scenario && argv[i][0] != '-') {
+            scenario = argv[i];
+        } else {
+            scenario = nullptr;
+            break;
+        }
+    }
+    if (!scenario) {
+        fprintf(stderr, "usage: %s <scenario> [--output FILE] [--seed N] [--vcd FILE]\n", argv[0]);
+        return 2;
+    }
+    if (!loadScenario(scenario)) {
+        return 1;
+    }
+    if (seed >= 0) {
+        rng.seed(seed);
+    }
+    if (outputPath && !(output = fopen(outputPath, "w"))) {
+        perror(outputPath);
+        return 1;
+    }
+
+    timespec wallStart;
+    clock_gettime(CLOCK_MONOTONIC, &wallStart);
+
+    hostSerialAttach(-1, -1);
+    hostSerialCapture(captureOutput);
+    hostBegin(HOST_VIRTUAL_TIME);
+    if (vcdPath && !hostTraceOpen(vcdPath, RIG_PINS, RIG_PIN_COUNT)) {
+        perror(vcdPath);
+        return 1;
+    }
+    setup();
+    for (Behaviour& b : behaviours) {
+        b.contact = false;
+        b.nextEdge = b.start; // A release at the start time is a no-op that schedules the first contact
+        if (b.kind == BURSTS || b.kind == TRAINS) {
+            b.remaining = 1;
+        }
+    }
+
+    const uint64_t end = toMicros(sessionLength);
+    size_t nextCommand = 0;
+    uint64_t loopPasses = 0;
+    while (hostMicros() < end) {
+        uint64_t now = hostMicros();
+        uint64_t next = (now / 1000 + 1) * 1000; // Next scheduler tick
+        if (nextCommand < commands.size()) {
+            uint64_t due = toMicros(commands[nextCommand].time);
+            next = due < next ? (due > now ? due : now) : next;
+        }
+        for (const Behaviour& b : behaviours) {
+            uint64_t due = toMicros(b.nextEdge);
+            if (hasPendingEdge(b) && due < next) {
+                next = due > now ? due : now;
+            }
+        }
+        if (next > end) {
+            next = end;
+        }
+        hostAdvance(next - now);
+
+        for (; nextCommand < commands.size() && toMicros(commands[nextCommand].time) <= next; nextCommand++) {
+            std::string line = commands[nextCommand].text + "\n";
+            hostSerialInject(line.data(), line.size());
+        }
+        for (Behaviour& b : behaviours) {
+            while (hasPendingEdge(b) && toMicros(b.nextEdge) <= next) {
+                applyEdge(b);
+            }
+        }
+        loop();
+        hostSerialFlush();
+        loopPasses++;
+    }
+    hostSerialFlush();
+    hostTraceClose();
+    if (output != stdout) {
+        fclose(output);
+    }
+
+    timespec wallEnd;
+    clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+    double wallSeconds = (wallEnd.tv_sec - wallStart.tv_sec) + (wallEnd.tv_nsec - wallStart.tv_nsec) / 1e9;
+    fprintf(stderr, "SIMULATED %.1f s in %.2f s (%llu loop passes)\n", sessionLength, wallSeconds,
+            static_cast<unsigned long long>(loopPasses));
+    for (const Behaviour& b : behaviours) {
+        fprintf(stderr, "INPUT,PIN %u,%llu contacts\n", b.pin, static_cast<unsigned long long>(b.count));
+    }
+    for (const auto& entry : eventCounts) {
+        fprintf(stderr, "OUTPUT,%s,%llu\n", entry.first.c_str(), static_cast<unsigned long long>(entry.second));
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HostHAL.h"
+#include "Timebase.h"
+
+/*
+  Checks the 64-bit timebase against the virtual clock across micros() and millis()
+  roll-overs.
+
+  Usage: timebase-test [--wraps N] [--seed S]
+
+  On the virtual clock micros() is the low 32 bits of hostMicros(), as on the board,
+  so timebaseMicros() must equal hostMicros() exactly. The clock is stepped up to and
+  through N micros() roll-overs (default 8, about 9.5 hours): a microsecond at a time
+  around each wrap, including a read of exactly 0xFFFFFFFF followed by 0, then on to
+  the next wrap in random steps of up to one scheduler tick (odd wraps) or in a single
+  step, the sparsest reads the timebase allows (just under one roll-over period). A
+  session epoch taken before the first wrap must give session times that keep counting
+  through every wrap, and a timestamp from before the epoch must give 0 on both the
+  timebase and the millis() clock. The clock
+  is then moved past the 32-bit millis() wrap (about 49.7 days), read twice per
+  micros() roll-over, to check
+  sessionMicrosFromMillis() across it. Prints
+    TIMEBASE,<wraps>,<reads>,<max error us>
+  and exits with 1 on any mismatch or a timestamp that goes backwards.
+*/
+
+static uint64_t reads = 0;            ///< timebaseMicros() calls checked.
+static uint32_t failures = 0;         ///< Checks that failed.
+static uint64_t lastTimestamp = 0;    ///< Previous timebaseMicros() value.
+static uint64_t maxError = 0;         ///< Largest |timebaseMicros() - hostMicros()| (us).
+
+/**
+ * @brief Reads the timebase and checks it against the virtual clock.
+ */
+static void check() {
+    uint64_t timestamp = timebaseMicros();
+    uint64_t expected = hostMicros();
+    uint64_t error = timestamp > expected ? timestamp - expected : expected - timestamp;
+    maxError = error > maxError ? error : maxError;
+    if ((error || timestamp < lastTimestamp) && failures++ < 10) {
+        fprintf(stderr, "timebase-test: read %llu us at %llu us (previous %llu us)\n",
+                static_cast<unsigned long long>(timestamp), static_cast<unsigned long long>(expected),
+                static_cast<unsigned long long>(lastTimestamp));
+    }
+    lastTimestamp = timestamp;
+    reads++;
+}
+
+/**
+ * @brief Moves the clock to a time, which must not be in the past.
+ * @param time Target time (us since hostBegin()).
+ */
+static void advanceTo(uint64_t time) {
+    hostAdvance(time - hostMicros());
+}
+
+int main(int argc, char** argv) {
+    uint32_t wraps = 8;
+    unsigned long seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--wraps") == 0 && i + 1 < argc) {
+            wraps = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--wraps N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> tickStep(1, 1000);
+    const uint64_t WRAP = 1ULL << 32;
+
+    hostBegin(HOST_VIRTUAL_TIME);
+    timebaseBegin(nullptr);
+    check();
+    advanceTo(1000000);
+    timebaseStartEpoch();
+    const uint64_t epoch = hostMicros();
+    if (sessionMicros(epoch - 500000) != 0 && failures++ < 10) {
+        fprintf(stderr, "timebase-test: a timestamp before the epoch does not clamp to 0\n");
+    }
+    if ((sessionMicrosFromMillis(millis() - 500) != 0 || sessionMicrosFromMillis(millis() + 2000) != 2000000) &&
+        failures++ < 10) {
+        fprintf(stderr, "timebase-test: a millis() timestamp around the epoch is not placed on the session clock\n");
+    }
+
+    for (uint64_t wrap = 1; wrap <= wraps; wrap++) {
+        uint64_t edge = wrap * WRAP;
+        advanceTo(edge - 5000);
+        check();
+        while (hostMicros() < edge + 5000) { // Every microsecond around the wrap
+            hostAdvance(1);
+            check();
+        }
+        if (wrap % 2) { // Scheduler-paced reads up to the next wrap
+            while (hostMicros() < edge + WRAP - 6000) {
+                hostAdvance(tickStep(rng));
+                check();
+            }
+        } else { // One read as late as allowed: just under a roll-over period after the last
+            advanceTo(edge + WRAP - 6000);
+            check();
+        }
+        if (sessionMicros(timebaseMicros()) != hostMicros() - epoch && failures++ < 10) {
+            fprintf(stderr, "timebase-test: session time wrong after %llu wraps\n", static_cast<unsigned long long>(wrap));
+        }
+    }
+
+    const uint64_t MILLIS_WRAP = WRAP * 1000;
+    uint32_t before = millis();
+    while (hostMicros() + WRAP / 2 < MILLIS_WRAP + 250000) { // Read at least once per micros() roll-over
+        hostAdvance(WRAP / 2);
+        check();
+    }
+    advanceTo(MILLIS_WRAP + 250000);
+    uint64_t expected = (hostMicros() - epoch) / 1000 * 1000;
+    if ((millis() >= before || sessionMicrosFromMillis(millis()) != expected) && failures++ < 10) {
+        fprintf(stderr, "timebase-test: session time from millis() wrong across its wrap (%llu us, expected %llu us)\n",
+                static_cast<unsigned long long>(sessionMicrosFromMillis(millis())),
+                static_cast<unsigned long long>(expected));
+    }
+
+    printf("TIMEBASE,%u,%llu,%llu\n", wraps, static_cast<unsigned long long>(reads),
+           static_cast<unsigned long long>(maxError));
+    return failures ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HostHAL.h"
+#include "RigPins.h"
+
+/*
+  Runs a paradigm sketch as a Linux process.
+
+  Usage: <sketch> [--virtual] [--pty] [--loop-us N] [--duration S] [--vcd FILE]
+  - --virtual     run on a virtual clock that advances N us per loop() pass instead of the wall clock
+  - --pty         serve the serial port on a new pseudo-terminal (path printed to stderr) instead of stdin/stdout
+  - --loop-us N   time per loop() pass, in us (default 100); the real-time clock sleeps this long
+  - --duration S  exit after S seconds on the sketch's clock (default: run until interrupted)
+  - --vcd FILE    record the rig's pins to a VCD waveform file (open with GTKWave)
+
+  Example: printf 'LINK\nARM_LEVER_RH\nSTART-PROGRAM\n' | ./operant_FR --virtual --duration 10
+*/
+
+static volatile sig_atomic_t stopRequested = 0; ///< Set by SIGINT/SIGTERM.
+
+/**
+ * @brief Requests a clean exit so buffered serial output is not lost.
+ * @param signal Signal number.
+ */
+static void requestStop(int signal) {
+    (void)signal;
+    stopRequested = 1;
+}
+
+/**
+ * @brief Prints the command-line usage.
+ * @param program Name the program was run as.
+ */
+static void printUsage(const char* program) {
+    fprintf(stderr, "usage: %s [--virtual] [--pty] [--loop-us N] [--duration S] [--vcd FILE]\n", program);
+}
+
+int main(int argc, char** argv) {
+    HOST_CLOCK clock = HOST_REAL_TIME;
+    bool usePty = false;
+    uint64_t loopMicros = 100;
+    uint64_t durationMicros = 0;
+    const char* vcdPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--virtual") == 0) {
+            clock = HOST_VIRTUAL_TIME;
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            usePty = true;
+        } else if (strcmp(argv[i], "--loop-us") == 0 && i + 1 < argc) {
+            loopMicros = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            durationMicros = static_cast<uint64_t>(strtod(argv[++i], nullptr) * 1e6);
+        } else if (strcmp(argv[i], "--vcd") == 0 && i + 1 < argc) {
+            vcdPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (usePty) {
+        char name[64];
+        if (!hostSerialOpenPty(name, sizeof(name))) {
+            perror("pty");
+            return 1;
+        }
+        fprintf(stderr, "SERIAL: %s\n", name);
+    }
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+    signal(SIGPIPE, SIG_IGN);
+
+    hostBegin(clock);
+    if (vcdPath && !hostTraceOpen(vcdPath, RIG_PINS, RIG_PIN_COUNT)) {
+        perror(vcdPath);
+        return 1;
+    }
+    setup();
+    hostSerialFlush();
+    while (!stopRequested && (durationMicros == 0 || hostMicros() < durationMicros)) {
+        loop();
+        hostSerialFlush();
+        hostAdvance(loopMicros);
+    }
+    hostSerialFlush();
+    hostTraceClose();
+    return 0;
+}
\ No newline at end of file
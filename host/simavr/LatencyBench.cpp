@@ -0,0 +1,276 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_irq.h>
+#include <simavr/avr_ioport.h>
+#include <simavr/avr_uart.h>
+}
+
+/*
+  Measures press-to-actuation latency of a paradigm's real AVR image in simavr.
+
+  Usage: reacher_latency <firmware.elf> [--name NAME] [--presses N]
+
+  The firmware runs on a simulated ATmega328P at 16 MHz. After setup, the harness
+  links, arms the levers, cue, pump and laser (active-press mode), and starts the
+  program over the simulated UART. It then presses the right-hand (active) and
+  left-hand (inactive) levers N times each. For every press it records, in CPU
+  cycles:
+  - CUE, PUMP, LASER: lever edge to the first change of pin 3, 4 or 6
+  - SERIAL_PRESS: lever press to the last bit of the first event line sent after it
+  - SERIAL_RELEASE: lever release to the last bit of the first event line sent after it
+  Results are printed as CSV: LATENCY,<name>,<lever>,<signal>,<n>,<min>,<mean>,<max>,<max us>.
+  A signal that never changed within the window (e.g., no reward under the schedule) has n = 0.
+*/
+
+static const uint32_t CPU_FREQUENCY = 16000000;                  ///< UNO clock (Hz).
+static const uint32_t CYCLES_PER_MICRO = CPU_FREQUENCY / 1000000; ///< Cycles per microsecond.
+static const uint32_t BAUDRATE = 115200;                          ///< Firmware baud rate.
+static const uint32_t CYCLES_PER_BYTE = CPU_FREQUENCY / BAUDRATE * 10; ///< One start, 8 data, 1 stop bit.
+static const uint32_t BYTE_GAP = 1000 * CYCLES_PER_MICRO;         ///< Spacing of injected UART bytes.
+static const uint64_t LATENCY_WINDOW = 100000ULL * CYCLES_PER_MICRO; ///< Longest latency recorded (100 ms).
+
+/**
+ * @enum SIGNAL
+ * @brief Outputs whose latency is measured.
+ */
+enum SIGNAL {
+    SIGNAL_CUE,                      ///< Cue speaker, pin 3 (PD3).
+    SIGNAL_PUMP,                     ///< Pump, pin 4 (PD4).
+    SIGNAL_LASER,                    ///< Laser, pin 6 (PD6).
+    SIGNAL_SERIAL_PRESS,             ///< First event line after a press.
+    SIGNAL_SERIAL_RELEASE,           ///< First event line after a release.
+    SIGNAL_COUNT
+};
+
+static const char* const SIGNAL_NAMES[SIGNAL_COUNT] = {"CUE", "PUMP", "LASER", "SERIAL_PRESS", "SERIAL_RELEASE"};
+static const uint8_t SIGNAL_PINS[3] = {3, 4, 6}; ///< PORTD bits of the cue, pump and laser.
+
+/**
+ * @struct Stats
+ * @brief Latency samples of one signal (cycles).
+ */
+struct Stats {
+    uint32_t count;                  ///< Number of samples.
+    uint64_t total;                  ///< Sum of samples.
+    uint64_t minimum;                ///< Smallest sample.
+    uint64_t maximum;                ///< Largest sample.
+};
+
+static avr_t* avr = nullptr;                  ///< Simulated MCU.
+static uint64_t markCycle[SIGNAL_COUNT];      ///< Edge the pending measurement started at, or 0.
+static Stats stats[2][SIGNAL_COUNT];          ///< Samples per lever (RH, LH) and signal.
+static int lever = 0;                         ///< Lever being measured (0 = RH, 1 = LH).
+static std::string line;                      ///< UART output since the last newline.
+static std::vector<uint8_t> pendingInput;     ///< Bytes waiting to be sent to the UART.
+
+/**
+ * @brief Adds a latency sample to a signal's statistics.
+ * @param signal Signal measured.
+ * @param cycles Latency (cycles).
+ */
+static void record(SIGNAL signal, uint64_t cycles) {
+    Stats& s = stats[lever][signal];
+    if (s.count == 0 || cycles < s.minimum) {
+        s.minimum = cycles;
+    }
+    if (cycles > s.maximum) {
+        s.maximum = cycles;
+    }
+    s.total += cycles;
+    s.count++;
+}
+
+/**
+ * @brief Completes a pending measurement if it started within the window.
+ * @param signal Signal measured.
+ * @param cycle Cycle the signal changed (or finished transmitting).
+ */
+static void complete(SIGNAL signal, uint64_t cycle) {
+    if (markCycle[signal] && cycle - markCycle[signal] <= LATENCY_WINDOW) {
+        record(signal, cycle - markCycle[signal]);
+    }
+    markCycle[signal] = 0;
+}
+
+/**
+ * @brief Notified when an output pin changes.
+ * @param irq Pin IRQ.
+ * @param value New level.
+ * @param param Signal (as an integer).
+ */
+static void onPinChange(avr_irq_t* irq, uint32_t value, void* param) {
+    (void)irq;
+    (void)value;
+    complete(static_cast<SIGNAL>(reinterpret_cast<uintptr_t>(param)), avr->cycle);
+}
+
+/**
+ * @brief Notified for every byte the firmware writes to the UART.
+ *
+ * An event line is complete once its newline has been shifted out; lines that do not
+ * start with a letter (e.g., the "200" ping) are ignored.
+ *
+ * @param irq UART output IRQ.
+ * @param value Byte written.
+ * @param param Unused.
+ */
+static void onUartByte(avr_irq_t* irq, uint32_t value, void* param) {
+    (void)irq;
+    (void)param;
+    if (value != '\n') {
+        line.push_back(static_cast<char>(value));
+        return;
+    }
+    bool eventLine = !line.empty() && line[0] >= 'A' && line[0] <= 'Z' && line.find(',') != std::string::npos;
+    line.clear();
+    if (eventLine) {
+        uint64_t transmitted = avr->cycle + CYCLES_PER_BYTE;
+        complete(SIGNAL_SERIAL_PRESS, transmitted);
+        complete(SIGNAL_SERIAL_RELEASE, transmitted);
+    }
+}
+
+/**
+ * @brief Runs the simulation until a cycle, feeding queued UART input on the way.
+ * @param until Cycle to stop at.
+ * @return Boolean indicating the firmware is still running.
+ */
+static bool runUntil(uint64_t until) {
+    uint64_t nextByte = avr->cycle;
+    avr_irq_t* uartInput = avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT);
+    while (avr->cycle < until) {
+        if (!pendingInput.empty() && avr->cycle >= nextByte) {
+            avr_raise_irq(uartInput, pendingInput.front());
+            pendingInput.erase(pendingInput.begin());
+            nextByte = avr->cycle + BYTE_GAP;
+        }
+        int state = avr_run(avr);
+        if (state == cpu_Done || state == cpu_Crashed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Queues a serial command and lets the firmware process it.
+ * @param command Command, without the newline.
+ * @return Boolean indicating the firmware is still running.
+ */
+static bool sendCommand(const char* command) {
+    pendingInput.insert(pendingInput.end(), command, command + strlen(command));
+    pendingInput.push_back('\n');
+    return runUntil(avr->cycle + (strlen(command) + 1) * BYTE_GAP + 50000ULL * CYCLES_PER_MICRO);
+}
+
+/**
+ * @brief Converts milliseconds to cycles.
+ * @param ms Time (ms).
+ * @return Cycles.
+ */
+static uint64_t cyclesFromMillis(uint64_t ms) {
+    return ms * 1000 * CYCLES_PER_MICRO;
+}
+
+int main(int argc, char** argv) {
+    const char* firmwarePath = nullptr;
+    const char* name = nullptr;
+    int presses = 10;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--presses") == 0 && i + 1 < argc) {
+            presses = atoi(argv[++i]);
+        } else if (!firmwarePath) {
+            firmwarePath = argv[i];
+        }
+    }
+    if (!firmwarePath) {
+        fprintf(stderr, "usage: %s <firmware.elf> [--name NAME] [--presses N]\n", argv[0]);
+        return 2;
+    }
+    if (!name) {
+        name = firmwarePath;
+    }
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+    if (elf_read_firmware(firmwarePath, &firmware) != 0) {
+        fprintf(stderr, "%s: cannot read firmware\n", firmwarePath);
+        return 1;
+    }
+    avr = avr_make_mcu_by_name("atmega328p");
+    if (!avr) {
+        fprintf(stderr, "simavr has no atmega328p core\n");
+        return 1;
+    }
+    avr_init(avr);
+    firmware.frequency = CPU_FREQUENCY;
+    avr_load_firmware(avr, &firmware);
+
+    // Keep the UART off the terminal; bytes are collected by onUartByte()
+    uint32_t uartFlags = 0;
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &uartFlags);
+    uartFlags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &uartFlags);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), onUartByte, nullptr);
+    for (int signal = SIGNAL_CUE; signal <= SIGNAL_LASER; signal++) {
+        avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), SIGNAL_PINS[signal]),
+                                onPinChange, reinterpret_cast<void*>(static_cast<uintptr_t>(signal)));
+    }
+
+    // Levers are pulled up: pin 10 is PB2 and pin 13 is PB5
+    avr_irq_t* leverPins[2] = {avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B'), 2),
+                               avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B'), 5)};
+    avr_raise_irq(leverPins[0], 1);
+    avr_raise_irq(leverPins[1], 1);
+
+    const char* const sessionCommands[] = {
+        "LINK", "ARM_LEVER_RH", "ARM_LEVER_LH", "ARM_CS", "ARM_PUMP", "ARM_LASER",
+        "LASER_STIM_MODE_ACTIVE-PRESS", "LASER_DURATION:1", "SET_TIMEOUT_PERIOD_LENGTH:0", "START-PROGRAM"
+    };
+    bool running = runUntil(cyclesFromMillis(2500)); // setup() waits 2 s before serial starts
+    for (size_t i = 0; running && i < sizeof(sessionCommands) / sizeof(sessionCommands[0]); i++) {
+        running = sendCommand(sessionCommands[i]);
+    }
+    running = running && runUntil(avr->cycle + cyclesFromMillis(1500)); // Let the link jingle finish
+
+    for (int press = 0; running && press < 2 * presses; press++) {
+        lever = press % 2;
+        for (int signal = 0; signal < SIGNAL_COUNT; signal++) {
+            markCycle[signal] = 0;
+        }
+        for (int signal = SIGNAL_CUE; signal <= SIGNAL_SERIAL_PRESS; signal++) {
+            markCycle[signal] = avr->cycle;
+        }
+        avr_raise_irq(leverPins[lever], 0);
+        running = runUntil(avr->cycle + cyclesFromMillis(200));
+        markCycle[SIGNAL_SERIAL_RELEASE] = avr->cycle;
+        avr_raise_irq(leverPins[lever], 1);
+        running = running && runUntil(avr->cycle + cyclesFromMillis(2800)); // Cue, infusion and laser end
+    }
+    if (!running) {
+        fprintf(stderr, "%s: firmware stopped at cycle %llu\n", name, static_cast<unsigned long long>(avr->cycle));
+        return 1;
+    }
+
+    static const char* const LEVER_NAMES[2] = {"RH", "LH"};
+    for (int l = 0; l < 2; l++) {
+        for (int signal = 0; signal < SIGNAL_COUNT; signal++) {
+            const Stats& s = stats[l][signal];
+            printf("LATENCY,%s,%s,%s,%u,%llu,%llu,%llu,%.1f\n", name, LEVER_NAMES[l], SIGNAL_NAMES[signal], s.count,
+                   static_cast<unsigned long long>(s.minimum),
+                   static_cast<unsigned long long>(s.count ? s.total / s.count : 0),
+                   static_cast<unsigned long long>(s.maximum),
+                   static_cast<double>(s.maximum) / CYCLES_PER_MICRO);
+        }
+    }
+    return 0;
+}
\ No newline at end of file
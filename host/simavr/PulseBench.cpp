@@ -0,0 +1,248 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_irq.h>
+#include <simavr/avr_ioport.h>
+#include <simavr/avr_uart.h>
+}
+
+/*
+  Measures the timing of the laser pulse train of a paradigm's real AVR image in simavr.
+
+  Usage: reacher_pulses <firmware.elf> [--name NAME] [--frequency HZ] [--width US] [--trains N]
+
+  The firmware runs on a simulated ATmega328P at 16 MHz. After setup, the harness
+  links, arms the laser in cycle mode (1 s on, 1 s off) at the given frequency and
+  pulse width (0 = half the period), arms the frame input and starts the program over
+  the simulated UART. Frame pulses arrive on pin 2 at 30 Hz throughout, so the train
+  is timed while the firmware services frame interrupts, sends event lines and runs
+  its scheduler. Every edge of pin 6 (PD6) is recorded to the CPU cycle over N trains.
+
+  Prints one CSV row:
+    PULSE,<name>,<hz>,<width us>,<pulses>,<period min us>,<period max us>,
+    <width min us>,<width max us>,<peak jitter us>
+  where the jitter is the largest deviation of any period or width from its nominal
+  value. Periods are taken between rising edges of the same train.
+*/
+
+static const uint32_t CPU_FREQUENCY = 16000000;                  ///< UNO clock (Hz).
+static const uint32_t CYCLES_PER_MICRO = CPU_FREQUENCY / 1000000; ///< Cycles per microsecond.
+static const uint32_t BYTE_GAP = 1000 * CYCLES_PER_MICRO;         ///< Spacing of injected UART bytes.
+static const uint64_t FRAME_PERIOD = CPU_FREQUENCY / 30;           ///< Frame pulse interval (30 Hz).
+static const uint64_t FRAME_WIDTH = 1000 * CYCLES_PER_MICRO;       ///< Frame pulse length (1 ms).
+
+/**
+ * @struct Range
+ * @brief Smallest and largest of a set of intervals (cycles).
+ */
+struct Range {
+    uint32_t count;                  ///< Number of samples.
+    uint64_t minimum;                ///< Smallest sample.
+    uint64_t maximum;                ///< Largest sample.
+};
+
+static avr_t* avr = nullptr;                  ///< Simulated MCU.
+static avr_irq_t* framePin = nullptr;         ///< Timestamp trigger input, pin 2 (PD2).
+static uint64_t nextFrameEdge = 0;            ///< Cycle of the next frame pulse edge.
+static bool frameHigh = false;                ///< Level the frame input is driven to.
+static std::vector<uint64_t> risingEdges;     ///< Cycles of the laser's rising edges.
+static std::vector<uint64_t> fallingEdges;    ///< Cycles of the laser's falling edges.
+static std::vector<uint8_t> pendingInput;     ///< Bytes waiting to be sent to the UART.
+
+/**
+ * @brief Adds a sample to a range.
+ * @param range Range to update.
+ * @param cycles Interval (cycles).
+ */
+static void record(Range& range, uint64_t cycles) {
+    if (range.count == 0 || cycles < range.minimum) {
+        range.minimum = cycles;
+    }
+    if (cycles > range.maximum) {
+        range.maximum = cycles;
+    }
+    range.count++;
+}
+
+/**
+ * @brief Notified when the laser pin changes.
+ * @param irq Pin IRQ.
+ * @param value New level.
+ * @param param Unused.
+ */
+static void onLaserChange(avr_irq_t* irq, uint32_t value, void* param) {
+    (void)irq;
+    (void)param;
+    (value ? risingEdges : fallingEdges).push_back(avr->cycle);
+}
+
+/**
+ * @brief Runs the simulation until a cycle, feeding frame pulses and queued UART input.
+ * @param until Cycle to stop at.
+ * @return Boolean indicating the firmware is still running.
+ */
+static bool runUntil(uint64_t until) {
+    uint64_t nextByte = avr->cycle;
+    avr_irq_t* uartInput = avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT);
+    while (avr->cycle < until) {
+        if (!pendingInput.empty() && avr->cycle >= nextByte) {
+            avr_raise_irq(uartInput, pendingInput.front());
+            pendingInput.erase(pendingInput.begin());
+            nextByte = avr->cycle + BYTE_GAP;
+        }
+        if (avr->cycle >= nextFrameEdge) {
+            frameHigh = !frameHigh;
+            avr_raise_irq(framePin, frameHigh);
+            nextFrameEdge += frameHigh ? FRAME_WIDTH : FRAME_PERIOD - FRAME_WIDTH;
+        }
+        int state = avr_run(avr);
+        if (state == cpu_Done || state == cpu_Crashed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Queues a serial command and lets the firmware process it.
+ * @param command Command, without the newline.
+ * @return Boolean indicating the firmware is still running.
+ */
+static bool sendCommand(const char* command) {
+    pendingInput.insert(pendingInput.end(), command, command + strlen(command));
+    pendingInput.push_back('\n');
+    return runUntil(avr->cycle + (strlen(command) + 1) * BYTE_GAP + 50000ULL * CYCLES_PER_MICRO);
+}
+
+/**
+ * @brief Converts milliseconds to cycles.
+ * @param ms Time (ms).
+ * @return Cycles.
+ */
+static uint64_t cyclesFromMillis(uint64_t ms) {
+    return ms * 1000 * CYCLES_PER_MICRO;
+}
+
+/**
+ * @brief Converts cycles to microseconds.
+ * @param cycles Interval (cycles).
+ * @return Interval (us).
+ */
+static double microsFromCycles(uint64_t cycles) {
+    return static_cast<double>(cycles) / CYCLES_PER_MICRO;
+}
+
+int main(int argc, char** argv) {
+    const char* firmwarePath = nullptr;
+    const char* name = nullptr;
+    uint32_t frequency = 20;
+    uint32_t width = 0;
+    int trains = 3;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--frequency") == 0 && i + 1 < argc) {
+            frequency = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--width") == 0 && i + 1 < argc) {
+            width = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--trains") == 0 && i + 1 < argc) {
+            trains = atoi(argv[++i]);
+        } else if (!firmwarePath) {
+            firmwarePath = argv[i];
+        }
+    }
+    if (!firmwarePath || frequency < 2) {
+        fprintf(stderr, "usage: %s <firmware.elf> [--name NAME] [--frequency HZ] [--width US] [--trains N]\n", argv[0]);
+        return 2;
+    }
+    if (!name) {
+        name = firmwarePath;
+    }
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+    if (elf_read_firmware(firmwarePath, &firmware) != 0) {
+        fprintf(stderr, "%s: cannot read firmware\n", firmwarePath);
+        return 1;
+    }
+    avr = avr_make_mcu_by_name("atmega328p");
+    if (!avr) {
+        fprintf(stderr, "simavr has no atmega328p core\n");
+        return 1;
+    }
+    avr_init(avr);
+    firmware.frequency = CPU_FREQUENCY;
+    avr_load_firmware(avr, &firmware);
+
+    // Keep the UART off the terminal; the event lines only add load
+    uint32_t uartFlags = 0;
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &uartFlags);
+    uartFlags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &uartFlags);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 6), onLaserChange, nullptr);
+    framePin = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 2);
+    avr_raise_irq(framePin, 0);
+
+    char frequencyCommand[32];
+    char widthCommand[32];
+    snprintf(frequencyCommand, sizeof(frequencyCommand), "LASER_FREQUENCY:%u", frequency);
+    snprintf(widthCommand, sizeof(widthCommand), "LASER_PULSE_WIDTH:%u", width);
+    const char* const sessionCommands[] = {
+        "LINK", "ARM_LASER", "ARM_FRAME", "LASER_STIM_MODE_CYCLE", "LASER_DURATION:1",
+        frequencyCommand, widthCommand, "START-PROGRAM"
+    };
+    bool running = runUntil(cyclesFromMillis(2500)); // setup() waits 2 s before serial starts
+    nextFrameEdge = avr->cycle;
+    for (size_t i = 0; running && i < sizeof(sessionCommands) / sizeof(sessionCommands[0]); i++) {
+        running = sendCommand(sessionCommands[i]);
+    }
+    running = running && runUntil(avr->cycle + cyclesFromMillis(2000ULL * trains + 500));
+    if (!running) {
+        fprintf(stderr, "%s: firmware stopped at cycle %llu\n", name, static_cast<unsigned long long>(avr->cycle));
+        return 1;
+    }
+
+    uint64_t nominalPeriod = CPU_FREQUENCY / frequency;
+    uint64_t nominalWidth = (width ? width : 500000 / frequency) * CYCLES_PER_MICRO;
+    Range periods = {0, 0, 0};
+    Range widths = {0, 0, 0};
+    size_t falling = 0;
+    for (size_t i = 0; i < risingEdges.size(); i++) {
+        if (i + 1 < risingEdges.size() && risingEdges[i + 1] - risingEdges[i] < 2 * nominalPeriod) {
+            record(periods, risingEdges[i + 1] - risingEdges[i]);
+        }
+        while (falling < fallingEdges.size() && fallingEdges[falling] <= risingEdges[i]) {
+            falling++;
+        }
+        if (falling < fallingEdges.size()) {
+            record(widths, fallingEdges[falling] - risingEdges[i]);
+        }
+    }
+    if (periods.count == 0 || widths.count == 0) {
+        fprintf(stderr, "%s: no pulses on pin 6\n", name);
+        return 1;
+    }
+
+    const int64_t deviations[4] = {
+        static_cast<int64_t>(periods.minimum - nominalPeriod), static_cast<int64_t>(periods.maximum - nominalPeriod),
+        static_cast<int64_t>(widths.minimum - nominalWidth), static_cast<int64_t>(widths.maximum - nominalWidth)
+    };
+    uint64_t jitter = 0;
+    for (int i = 0; i < 4; i++) {
+        uint64_t deviation = static_cast<uint64_t>(llabs(deviations[i]));
+        if (deviation > jitter) {
+            jitter = deviation;
+        }
+    }
+    printf("PULSE,%s,%u,%.1f,%u,%.3f,%.3f,%.3f,%.3f,%.3f\n", name, frequency,
+           microsFromCycles(nominalWidth), widths.count,
+           microsFromCycles(periods.minimum), microsFromCycles(periods.maximum),
+           microsFromCycles(widths.minimum), microsFromCycles(widths.maximum),
+           microsFromCycles(jitter));
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+  PinToggleBench
+
+  Measures the cost of driving and reading a pin through the Arduino calls, the
+  runtime-pin Pump, the compile-time FastPump and FastPin directly, in CPU cycles on
+  Timer1 at clk/1. Upload to an UNO with nothing wired to pins 7 and 8 and open the
+  serial monitor at 115200 baud, or build it with "make pin-bench".
+
+  Prints one line per method, repeated every few seconds:
+    TOGGLE,<method>,<cycles per call>,<ns per call>
+
+  Each figure is the mean over CALLS calls with interrupts off, less the cost of an
+  empty loop. Pump and FastPump are called through a Pump& as the core does, so
+  their figures include the virtual call.
+*/
+
+#include <FastPin.h>
+#include <FastPump.h>
+
+const uint8_t OUTPUT_PIN = 7;        ///< Unused on the rig; driven by every output method.
+const uint8_t INPUT_PIN = 8;         ///< Unused on the rig; read by every input method.
+const uint16_t CALLS = 200;          ///< Calls timed per method.
+
+Pump runtimePump(OUTPUT_PIN);        ///< Pump on digitalWrite().
+FastPump<OUTPUT_PIN> fastPump;       ///< Pump on direct port writes.
+
+volatile uint8_t sink;               ///< Keeps reads from being optimized away.
+
+/**
+ * @brief Starts Timer1 free-running at clk/1.
+ */
+void startTimer1() {
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+}
+
+/**
+ * @brief Turns a pump on and off through the base class, as the core does.
+ * @param pump Pump to drive.
+ */
+__attribute__((noinline)) void pulsePump(Pump& pump) {
+    pump.on();
+    pump.off();
+}
+
+/**
+ * @brief Times CALLS iterations of a statement.
+ * @param statement Statement to repeat.
+ * @return Cycles for all iterations; at most ~4 ms, so Timer1 does not wrap.
+ */
+#define TIME_CALLS(statement) ({                  \
+    noInterrupts();                               \
+    uint16_t start = TCNT1;                       \
+    for (uint16_t i = 0; i < CALLS; i++) {        \
+        statement;                                \
+        asm volatile("" ::: "memory");            \
+    }                                             \
+    uint16_t cycles = TCNT1 - start;              \
+    interrupts();                                 \
+    cycles;                                       \
+})
+
+/**
+ * @brief Writes one result line.
+ * @param method Method name.
+ * @param cycles Cycles for CALLS iterations, less the empty loop.
+ * @param callsPerIteration Calls made in each iteration.
+ */
+void report(const __FlashStringHelper* method, uint16_t cycles, uint8_t callsPerIteration) {
+    float perCall = static_cast<float>(cycles) / (static_cast<float>(CALLS) * callsPerIteration);
+    Serial.print(F("TOGGLE,"));
+    Serial.print(method);
+    Serial.print(',');
+    Serial.print(perCall, 2);
+    Serial.print(',');
+    Serial.println(perCall * 1000.0f / (F_CPU / 1000000UL), 1);
+}
+
+void setup() {
+    Serial.begin(115200);
+    pinMode(OUTPUT_PIN, OUTPUT);
+    pinMode(INPUT_PIN, INPUT_PULLUP);
+    startTimer1();
+}
+
+void loop() {
+    uint16_t empty = TIME_CALLS((void)0);
+
+    report(F("DIGITALWRITE"), TIME_CALLS(digitalWrite(OUTPUT_PIN, HIGH); digitalWrite(OUTPUT_PIN, LOW)) - empty, 2);
+    report(F("PUMP"), TIME_CALLS(pulsePump(runtimePump)) - empty, 2);
+    report(F("FASTPUMP"), TIME_CALLS(pulsePump(fastPump)) - empty, 2);
+    report(F("FASTPIN"), TIME_CALLS(FastPin<OUTPUT_PIN>::high(); FastPin<OUTPUT_PIN>::low()) - empty, 2);
+    report(F("FASTPIN_TOGGLE"), TIME_CALLS(FastPin<OUTPUT_PIN>::toggle()) - empty, 1);
+    report(F("DIGITALREAD"), TIME_CALLS(sink = digitalRead(INPUT_PIN)) - empty, 1);
+    report(F("FASTPIN_READ"), TIME_CALLS(sink = FastPin<INPUT_PIN>::read()) - empty, 1);
+
+    delay(5000);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "Command_Utils.h"
+#include <Arduino.h>
+
+/**
+ * @brief Collects serial bytes into a line buffer without blocking.
+ * 
+ * Consumes whatever is available and stops at the end of a line. Carriage returns
+ * are ignored. Bytes of a line longer than the buffer are dropped up to its newline,
+ * and the line is then reported as too long with its start in the buffer, so the
+ * caller can reject it rather than act on a truncated command.
+ * 
+ * @param buffer Line buffer; holds the null-terminated line (or its start) once one ends.
+ * @param size Size of the buffer.
+ * @return LINE_READY or LINE_TOO_LONG when a line has ended, otherwise LINE_PENDING.
+ */
+LINE_STATUS readCommandLine(char* buffer, size_t size) {
+    static size_t lineLength = 0;   // Bytes collected for the current line
+    static bool overflowed = false; // Current line exceeded the buffer
+    while (Serial.available() > 0) {
+        char c = static_cast<char>(Serial.read());
+        if (c == '\n') {
+            LINE_STATUS status = overflowed ? LINE_TOO_LONG : LINE_READY;
+            buffer[lineLength] = '\0';
+            lineLength = 0;
+            overflowed = false;
+            return status;
+        } else if (c != '\r') {
+            if (lineLength < size - 1) {
+                buffer[lineLength++] = c;
+            } else {
+                overflowed = true;
+            }
+        }
+    }
+    return LINE_PENDING;
+}
+
+/**
+ * @brief Finds the handler of the command matching a line in a sorted command table.
+ * 
+ * The lookup key is the line up to and including its first ':' (or the whole line),
+ * which is matched exactly against the table by binary search. Prefixes ending in
+ * ':' therefore take a parameter, and all others must match the whole line.
+ * 
+ * @param table Command table in PROGMEM, sorted by prefix.
+ * @param count Number of entries.
+ * @param line Null-terminated command line.
+ * @return Handler of the matching command, or nullptr if the command is unknown.
+ */
+CommandHandler findCommand(const Command* table, size_t count, const char* line) {
+    const char* colon = strchr(line, ':');
+    size_t keyLength = colon ? static_cast<size_t>(colon - line + 1) : strlen(line);
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        const char* prefix = table[mid].prefix;
+        int order = strncmp_P(line, prefix, keyLength);
+        if (order == 0 && pgm_read_byte(&prefix[keyLength]) != '\0') {
+            order = -1; // Key is a proper prefix of this entry, so it sorts first
+        }
+        if (order == 0) {
+            return reinterpret_cast<CommandHandler>(pgm_read_ptr(&table[mid].handler));
+        } else if (order < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef COMMAND_UTILS_H
+#define COMMAND_UTILS_H
+
+#include <Arduino.h>
+
+/**
+ * @file Command_Utils.h
+ * @brief Utility functions for assembling and dispatching serial commands.
+ * 
+ * Command tables are defined PROGMEM, with each prefix stored inside its entry, so
+ * neither the table nor its strings take SRAM on AVR; findCommand() reads them
+ * straight from flash.
+ */
+
+typedef void (*CommandHandler)(const char*); ///< Function pointer type for command handlers.
+
+const size_t COMMAND_PREFIX_SIZE = 29; ///< Longest command prefix ("LASER_STIM_MODE_ACTIVE-PRESS") plus its terminator.
+
+/**
+ * @struct Command
+ * @brief A serial command and its handler.
+ */
+struct Command {
+    char prefix[COMMAND_PREFIX_SIZE]; ///< Command prefix to match.
+    CommandHandler handler;           ///< Handler function for the command.
+};
+
+/**
+ * @brief Compares two strings at compile time, like strcmp().
+ * @param a First string.
+ * @param b Second string.
+ * @return Negative, zero or positive as a sorts before, equal to or after b.
+ */
+constexpr int compareStrings(const char* a, const char* b) {
+    return (*a != *b || *a == '\0') ? (*a - *b) : compareStrings(a + 1, b + 1);
+}
+
+/**
+ * @brief Checks at compile time that a command table is in strictly ascending order.
+ * @param table Command table.
+ * @param count Number of entries.
+ * @return Boolean indicating a sorted table.
+ */
+constexpr bool isSorted(const Command* table, size_t count) {
+    return count < 2 || (compareStrings(table[0].prefix, table[1].prefix) < 0 && isSorted(table + 1, count - 1));
+}
+
+/**
+ * @enum LINE_STATUS
+ * @brief Defines what readCommandLine() has assembled.
+ */
+enum LINE_STATUS { LINE_PENDING,  ///< No complete line yet.
+                   LINE_READY,    ///< The buffer holds a complete line.
+                   LINE_TOO_LONG  ///< A line overran the buffer; it holds the line's start.
+};
+
+/**
+ * @brief Collects serial bytes into a line buffer without blocking.
+ * @param buffer Line buffer; holds the null-terminated line (or its start) once one ends.
+ * @param size Size of the buffer.
+ * @return LINE_READY or LINE_TOO_LONG when a line has ended, otherwise LINE_PENDING.
+ */
+LINE_STATUS readCommandLine(char* buffer, size_t size);
+
+/**
+ * @brief Finds the handler of the command matching a line in a sorted command table.
+ * @param table Command table in PROGMEM, sorted by prefix.
+ * @param count Number of entries.
+ * @param line Null-terminated command line.
+ * @return Handler of the matching command, or nullptr if the command is unknown.
+ */
+CommandHandler findCommand(const Command* table, size_t count, const char* line);
+
+#endif // COMMAND_UTILS_H
\ No newline at end of file
@@ -10,7 +10,7 @@
  * @param initPin The digital pin (byte) to which the cue speaker is connected.
  */
 Cue::Cue(byte initPin) 
-    : Device(initPin), running(false), frequency(8000), duration(1600), onTimestamp(0), offTimestamp(0) {}
+    : Device(initPin), sounding(false), running(false), frequency(8000), duration(1600), onTimestamp(0), offTimestamp(0) {}
 
 /**
  * @brief Sets the running state of the cue.
@@ -28,7 +28,11 @@ void Cue::setRunning(bool initRunning) {
  */
 void Cue::setFrequency(int32_t initFrequency) {
     frequency = initFrequency;
-    Serial.println("SET CUE FREQUENCY TO: " + String(frequency));
+    if (sounding) {
+        tone(pin, frequency); // Retune a cue that is already playing
+    }
+    Serial.print(F("SET CUE FREQUENCY TO: "));
+    Serial.println(frequency);
 }
 
 /**
@@ -38,25 +42,34 @@ void Cue::setFrequency(int32_t initFrequency) {
  */
 void Cue::setDuration(int32_t initDuration) {
     duration = initDuration;
-    Serial.println("SET CUE DURATION TO: " + String(duration));
+    Serial.print(F("SET CUE DURATION TO: "));
+    Serial.println(duration);
 }
 
 /**
  * @brief Activates the cue speaker with the set frequency.
  * 
- * Starts playing a tone on the assigned pin at the specified frequency.
+ * Starts playing a tone on the assigned pin at the specified frequency. manageCue()
+ * calls this on every pass of a cue, so tone() (which reprograms Timer2 and restarts
+ * the waveform) is only called when no tone is playing.
  */
 void Cue::on() {
-    tone(pin, frequency);
+    if (!sounding) {
+        sounding = true;
+        tone(pin, frequency);
+    }
 }
 
 /**
  * @brief Deactivates the cue speaker.
  * 
- * Stops the tone on the assigned pin.
+ * Stops the tone on the assigned pin, if one is playing.
  */
 void Cue::off() {
-    noTone(pin);
+    if (sounding) {
+        sounding = false;
+        noTone(pin);
+    }
 }
 
 /**
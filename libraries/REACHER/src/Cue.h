@@ -20,6 +20,9 @@
  * frequency, duration, and on/off states based on timestamps.
  */
 class Cue : public Device {
+private:
+    bool sounding;        ///< Whether a tone is playing on the pin.
+
 public:
     bool running;         ///< Indicates whether the cue is currently playing a tone.
     int32_t frequency;    ///< Frequency (in Hz) of the tone to be played.
@@ -53,12 +56,12 @@ public:
     void setDuration(int32_t initDuration);
 
     /**
-     * @brief Turns the cue speaker on.
+     * @brief Turns the cue speaker on; starts the tone only if it is not playing.
      */
     void on();
 
     /**
-     * @brief Turns the cue speaker off.
+     * @brief Turns the cue speaker off; stops the tone only if it is playing.
      */
     void off();
 
@@ -0,0 +1,68 @@
+#include "Device.h"
+#include "Cue.h"
+#include "Cue_Utils.h"
+#include "TonePlayer.h"
+#include <Arduino.h>
+
+static const ToneNote LINK_JINGLE[] = {{500, 100}, {1000, 100}, {1500, 100}};   ///< Rising jingle played on link.
+static const ToneNote UNLINK_JINGLE[] = {{1500, 100}, {1000, 100}, {500, 100}}; ///< Falling jingle played on unlink.
+static TonePlayer jingle;                                                        ///< Plays the connection jingles.
+
+/**
+ * @brief Starts a connection or disconnection jingle based on the connection status.
+ * 
+ * This function generates an audible feedback using tones to indicate whether a device
+ * has been linked or unlinked from a GUI. The pitch increases for connection and decreases
+ * for disconnection. The jingle plays in the background through manageJingle(), so
+ * inputs keep being sampled while it sounds.
+ * 
+ * @param connected The connection status ("LINK" or "UNLINK").
+ * @param cue Reference to a Cue object controlling the speaker output pin.
+ * @param linkedToGUI Reference to a boolean flag tracking GUI connection status.
+ */
+void connectionJingle(const char* connected, Cue& cue, bool& linkedToGUI) {
+    if (strcmp(connected, "LINK") == 0) {
+        linkedToGUI = true;
+        cue.off();                                   // The jingle takes over the speaker
+        jingle.play(cue.getPin(), LINK_JINGLE, 3);   // 500, 1000, 1500 Hz for 100ms each
+        Serial.println(F("LINKED"));                 // Log connection status
+    } else if (strcmp(connected, "UNLINK") == 0) {
+        linkedToGUI = false;
+        cue.off();
+        jingle.play(cue.getPin(), UNLINK_JINGLE, 3); // 1500, 1000, 500 Hz for 100ms each
+        Serial.println(F("UNLINKED"));               // Log disconnection status
+    }
+}
+
+/**
+ * @brief Advances the connection jingle, if one is playing.
+ */
+void manageJingle() {
+    jingle.update();
+}
+
+/**
+ * @brief Manages the operation of a cue tone based on timestamps.
+ * 
+ * Controls the cue speaker by turning it on or off depending on whether the current time
+ * falls within the cue's designated on/off timestamp interval. The cue must be armed
+ * for this function to take effect, and it leaves the speaker alone while a
+ * connection jingle is playing.
+ * 
+ * @param cue Pointer to a Cue object (optional, nullptr if unused).
+ */
+void manageCue(Cue* cue) {
+    int32_t timestamp = static_cast<int32_t>(millis()); // Current time in milliseconds
+
+    if (cue != nullptr && !jingle.isPlaying()) {
+        if (cue->isArmed()) { // Check if cue is armed
+            if (timestamp <= cue->getOffTimestamp() && timestamp >= cue->getOnTimestamp()) {
+                cue->on();           // Activate cue speaker
+                cue->setRunning(true); // Update running state
+            } else {
+                cue->off();          // Deactivate cue speaker
+                cue->setRunning(false); // Update running state
+            }
+        }
+    }
+}
\ No newline at end of file
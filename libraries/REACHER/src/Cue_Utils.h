@@ -10,13 +10,18 @@
  */
 
 /**
- * @brief Plays a connection or disconnection jingle.
+ * @brief Starts a connection or disconnection jingle without blocking.
  * 
  * @param connected Connection status string ("LINK" or "UNLINK").
  * @param cue Reference to the Cue object for tone output.
  * @param linkedToGUI Reference to the GUI connection status flag.
  */
-void connectionJingle(String connected, Cue& cue, bool& linkedToGUI);
+void connectionJingle(const char* connected, Cue& cue, bool& linkedToGUI);
+
+/**
+ * @brief Advances the connection jingle; call at least once per millisecond.
+ */
+void manageJingle();
 
 /**
  * @brief Manages the state of a cue based on time intervals.
@@ -0,0 +1,137 @@
+#include "Debouncer.h"
+#include <Arduino.h>
+
+/**
+ * @brief Constructor for the Debouncer class.
+ *
+ * @param initState Idle level of the input.
+ * @param initDebounceTime Debounce time in milliseconds.
+ */
+Debouncer::Debouncer(bool initState, uint32_t initDebounceTime)
+    : previousState(initState), stableState(initState), pending(false), lastChange(0), edgeTime(0),
+      debounceTime(initDebounceTime * 1000) {}
+
+/**
+ * @brief Feeds a raw sample into the debouncer.
+ *
+ * Any raw transition restarts the debounce window; once the input has been
+ * steady for longer than the debounce time, a differing level becomes stable.
+ * The first sample to leave the stable level dates the edge, unless the input
+ * settles back at the stable level for the debounce time first.
+ *
+ * @param sample Raw input level.
+ * @param now Sample time in microseconds (wrap-around safe).
+ * @return EDGE_RISE or EDGE_FALL when the debounced state changes, otherwise EDGE_NONE.
+ */
+EDGE Debouncer::update(bool sample, uint32_t now) {
+    if (sample != previousState) {
+        lastChange = now;
+    }
+    previousState = sample;
+
+    if (sample != stableState) {
+        if (!pending) { // First sample away from the stable level
+            pending = true;
+            edgeTime = now;
+        }
+        if ((now - lastChange) > debounceTime) {
+            stableState = sample;
+            pending = false;
+            return sample ? EDGE_RISE : EDGE_FALL;
+        }
+    } else if (pending && (now - lastChange) > debounceTime) { // Settled back without an edge
+        pending = false;
+    }
+    return EDGE_NONE;
+}
+
+/**
+ * @brief Gets the time of the last debounced edge.
+ *
+ * @return Time of the first sample that left the old stable level (us, as passed to update()).
+ */
+uint32_t Debouncer::getEdgeTime() const {
+    return edgeTime;
+}
+
+/**
+ * @brief Sets the debounce time.
+ *
+ * @param initDebounceTime Debounce time in milliseconds.
+ */
+void Debouncer::setDebounceTime(uint32_t initDebounceTime) {
+    debounceTime = initDebounceTime * 1000;
+}
+
+/**
+ * @brief Gets the debounce time.
+ *
+ * @return Debounce time in milliseconds.
+ */
+uint32_t Debouncer::getDebounceTime() const {
+    return debounceTime / 1000;
+}
+
+/**
+ * @brief Gets the raw state at the previous sample.
+ *
+ * @return Boolean previous state.
+ */
+bool Debouncer::getPreviousState() const {
+    return previousState;
+}
+
+/**
+ * @brief Gets the debounced state.
+ *
+ * @return Boolean stable state.
+ */
+bool Debouncer::getStableState() const {
+    return stableState;
+}
+
+/**
+ * @brief Constructor for the PortDebouncer class.
+ *
+ * @param initBits Idle levels of the bits.
+ */
+PortDebouncer::PortDebouncer(uint8_t initBits)
+    : stableBits(initBits), counterLow(0), counterHigh(0) {}
+
+/**
+ * @brief Sets the stable levels and clears every counter.
+ *
+ * @param bits Levels to take as stable.
+ */
+void PortDebouncer::reset(uint8_t bits) {
+    stableBits = bits;
+    counterLow = 0;
+    counterHigh = 0;
+}
+
+/**
+ * @brief Feeds a raw port read into the debouncer.
+ *
+ * Bits that differ from their stable level count up (0, 1, 2, 3) and toggle on
+ * the fourth differing sample; bits that agree have their counters cleared.
+ *
+ * @param sample Raw levels.
+ * @return Mask of the bits whose debounced level changed.
+ */
+uint8_t PortDebouncer::update(uint8_t sample) {
+    uint8_t delta = sample ^ stableBits;
+    uint8_t toggled = delta & counterLow & counterHigh;
+    counterHigh = (counterHigh ^ counterLow) & delta;
+    counterLow = ~counterLow & delta;
+    stableBits ^= toggled;
+    return toggled;
+}
+
+/**
+ * @brief Gets the debounced levels.
+ *
+ * @return Stable bits.
+ */
+uint8_t PortDebouncer::getStableBits() const {
+    return stableBits;
+}
\ No newline at end of file
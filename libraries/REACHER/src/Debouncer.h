@@ -0,0 +1,131 @@
+#ifndef DEBOUNCER_H
+#define DEBOUNCER_H
+
+#include <Arduino.h>
+
+/**
+ * @file Debouncer.h
+ * @brief Defines the debouncer for digital inputs.
+ *
+ * Debouncer filters a single input and is owned by each input device, so every
+ * lever or lick circuit keeps its own debounce window. PortDebouncer instead
+ * filters all eight bits of a port read at once, for InputSampler's optional
+ * vertical-counter mode.
+ */
+
+/**
+ * @enum EDGE
+ * @brief Defines the debounced transitions reported by a debouncer.
+ */
+enum EDGE { EDGE_NONE, ///< No debounced transition.
+            EDGE_RISE, ///< Input settled HIGH.
+            EDGE_FALL  ///< Input settled LOW.
+};
+
+/**
+ * @class Debouncer
+ * @brief Time-based debouncer for a single digital input.
+ *
+ * A new level is accepted once the raw input has stayed unchanged for longer
+ * than the debounce time. The edge is dated by the first sample that left the
+ * stable level, so contact bounce and the debounce time do not delay it.
+ */
+class Debouncer {
+private:
+    bool previousState : 1; ///< Raw state at the previous sample.
+    bool stableState : 1;   ///< Debounced state.
+    bool pending : 1;       ///< Input has left the stable level and edgeTime is set.
+    uint32_t lastChange;    ///< Time of the last raw transition (us).
+    uint32_t edgeTime;      ///< Time of the first sample that left the stable level (us).
+    uint32_t debounceTime;  ///< Time the input must stay unchanged (us).
+
+public:
+    /**
+     * @brief Constructor for the Debouncer class.
+     * @param initState Idle level of the input.
+     * @param initDebounceTime Debounce time in milliseconds.
+     */
+    Debouncer(bool initState, uint32_t initDebounceTime);
+
+    /**
+     * @brief Feeds a raw sample into the debouncer.
+     * @param sample Raw input level.
+     * @param now Sample time in microseconds (wrap-around safe).
+     * @return EDGE_RISE or EDGE_FALL when the debounced state changes, otherwise EDGE_NONE.
+     */
+    EDGE update(bool sample, uint32_t now);
+
+    /**
+     * @brief Sets the debounce time.
+     * @param initDebounceTime Debounce time in milliseconds.
+     */
+    void setDebounceTime(uint32_t initDebounceTime);
+
+    /**
+     * @brief Gets the debounce time.
+     * @return Debounce time in milliseconds.
+     */
+    uint32_t getDebounceTime() const;
+
+    /**
+     * @brief Gets the time of the last debounced edge.
+     * @return Time of the first sample that left the old stable level (us, as passed to update()).
+     */
+    uint32_t getEdgeTime() const;
+
+    /**
+     * @brief Gets the raw state at the previous sample.
+     * @return Boolean previous state.
+     */
+    bool getPreviousState() const;
+
+    /**
+     * @brief Gets the debounced state.
+     * @return Boolean stable state.
+     */
+    bool getStableState() const;
+};
+
+/**
+ * @class PortDebouncer
+ * @brief Vertical-counter debouncer for the eight bits of a port read.
+ *
+ * Each bit has its own 2-bit counter, held across two bytes so that every bit
+ * is counted with a handful of logic operations per sample. A bit toggles after
+ * four consecutive samples that differ from its stable level; a sample that
+ * agrees resets its counter.
+ */
+class PortDebouncer {
+private:
+    uint8_t stableBits;  ///< Debounced levels.
+    uint8_t counterLow;  ///< Low bit of each bit's counter.
+    uint8_t counterHigh; ///< High bit of each bit's counter.
+
+public:
+    /**
+     * @brief Constructor for the PortDebouncer class.
+     * @param initBits Idle levels of the bits.
+     */
+    PortDebouncer(uint8_t initBits = 0);
+
+    /**
+     * @brief Sets the stable levels and clears every counter.
+     * @param bits Levels to take as stable.
+     */
+    void reset(uint8_t bits);
+
+    /**
+     * @brief Feeds a raw port read into the debouncer.
+     * @param sample Raw levels.
+     * @return Mask of the bits whose debounced level changed.
+     */
+    uint8_t update(uint8_t sample);
+
+    /**
+     * @brief Gets the debounced levels.
+     * @return Stable bits.
+     */
+    uint8_t getStableBits() const;
+};
+
+#endif // DEBOUNCER_H
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include "Event_Utils.h"
+#include "Timebase.h"
+#include <Arduino.h>
+
+extern EVENT_FORMAT eventFormat; ///< Current serial format for events.
+extern EventQueue eventQueue;    ///< Events waiting to be sent.
+
+static uint8_t pendingBytes[EVENT_LINE_SIZE]; ///< Formatted event awaiting TX buffer space.
+static size_t pendingLength = 0;              ///< Number of bytes in pendingBytes (0 if none).
+static uint16_t reportedDrops = 0;            ///< Dropped-record total last reported.
+
+/**
+ * @brief Computes a CRC-16/CCITT-FALSE checksum (poly 0x1021, init 0xFFFF).
+ * 
+ * @param data Bytes to checksum.
+ * @param length Number of bytes.
+ * @return The 16-bit checksum.
+ */
+uint16_t crc16(const uint8_t* data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    while (length--) {
+        crc ^= static_cast<uint16_t>(*data++) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief COBS-encodes a buffer so that it contains no zero bytes.
+ * 
+ * Each run of non-zero bytes is prefixed with a code byte giving the distance to
+ * the next (implicit) zero, which lets 0x00 be used as an unambiguous frame delimiter.
+ * 
+ * @param data Bytes to encode (at most 254).
+ * @param length Number of bytes.
+ * @param encoded Output buffer of at least length + 1 bytes.
+ * @return Number of encoded bytes.
+ */
+size_t cobsEncode(const uint8_t* data, size_t length, uint8_t* encoded) {
+    size_t codeIndex = 0; // Position of the current code byte
+    size_t writeIndex = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] == 0) {
+            encoded[codeIndex] = code;
+            codeIndex = writeIndex++;
+            code = 1;
+        } else {
+            encoded[writeIndex++] = data[i];
+            code++;
+        }
+    }
+    encoded[codeIndex] = code;
+    return writeIndex;
+}
+
+/**
+ * @brief Writes a 64-bit value into a buffer in little-endian order.
+ * 
+ * @param buffer Destination buffer.
+ * @param value Value to write.
+ */
+static void putUint64(uint8_t* buffer, uint64_t value) {
+    for (uint8_t i = 0; i < 8; i++) {
+        buffer[i] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+/**
+ * @brief Builds a delimited binary frame for an event.
+ * 
+ * Packs the record, appends its CRC, COBS-encodes the result and surrounds it
+ * with 0x00 delimiters.
+ * 
+ * @param event Event to encode.
+ * @param frame Output buffer of at least EVENT_FRAME_SIZE bytes.
+ * @return Number of bytes in the frame.
+ */
+size_t encodeEventFrame(const EventRecord& event, uint8_t* frame) {
+    uint8_t payload[EVENT_PAYLOAD_SIZE + 2];
+    payload[0] = event.type;
+    payload[1] = event.source;
+    payload[2] = event.detail;
+    putUint64(&payload[3], event.start);
+    putUint64(&payload[11], event.end);
+    uint16_t crc = crc16(payload, EVENT_PAYLOAD_SIZE);
+    payload[EVENT_PAYLOAD_SIZE] = static_cast<uint8_t>(crc);
+    payload[EVENT_PAYLOAD_SIZE + 1] = static_cast<uint8_t>(crc >> 8);
+
+    frame[0] = 0x00;
+    size_t length = 1 + cobsEncode(payload, sizeof(payload), &frame[1]);
+    frame[length++] = 0x00;
+    return length;
+}
+
+/**
+ * @brief Retrieves the text label of an event source.
+ * 
+ * @param source EVENT_SOURCE of the event.
+ * @return Label as it appears in the CSV log (e.g., "RH_LEVER").
+ */
+static const __FlashStringHelper* sourceLabel(uint8_t source) {
+    switch (source) {
+        case SOURCE_RH_LEVER: return F("RH_LEVER");
+        case SOURCE_LH_LEVER: return F("LH_LEVER");
+        case SOURCE_PUMP: return F("PUMP");
+        case SOURCE_LASER: return F("LASER");
+        case SOURCE_LICK_CIRCUIT: return F("LICK_CIRCUIT");
+        case SOURCE_EVENT_QUEUE: return F("EVENT_QUEUE");
+        default: return F("FRAME_TIMESTAMP");
+    }
+}
+
+/**
+ * @brief Retrieves the text label of an event's action column.
+ * 
+ * @param event Event being written.
+ * @return Label as it appears in the CSV log (e.g., "ACTIVE_PRESS").
+ */
+static const __FlashStringHelper* actionLabel(const EventRecord& event) {
+    switch (event.type) {
+        case EVENT_LEVER_PRESS:
+            switch (event.detail) {
+                case DETAIL_ACTIVE: return F("ACTIVE_PRESS");
+                case DETAIL_INACTIVE: return F("INACTIVE_PRESS");
+                case DETAIL_TIMEOUT: return F("TIMEOUT_PRESS");
+                default: return F("NO CONDITION_PRESS");
+            }
+        case EVENT_INFUSION: return F("INFUSION");
+        case EVENT_STIM: return F("STIM");
+        case EVENT_DROPPED: return F("DROPPED");
+        case EVENT_BREAKPOINT: return F("BREAKPOINT");
+        default: return F("LICK");
+    }
+}
+
+/**
+ * @brief Appends a flash-resident label to a text buffer.
+ * 
+ * @param buffer Write position in the output buffer.
+ * @param label Label stored in flash.
+ * @return Write position after the label.
+ */
+static char* appendLabel(char* buffer, const __FlashStringHelper* label) {
+    strcpy_P(buffer, reinterpret_cast<const char*>(label));
+    return buffer + strlen(buffer);
+}
+
+/**
+ * @brief Appends an unsigned decimal number and a separator to a text buffer.
+ * 
+ * Digits are peeled off with 32-bit divisions only while the value needs them;
+ * the remaining (at most five) digits use 16-bit divisions, which are several
+ * times cheaper on AVR.
+ * 
+ * @param buffer Write position in the output buffer.
+ * @param value Number to append.
+ * @param separator Character written after the number.
+ * @return Write position after the separator.
+ */
+static char* appendNumber(char* buffer, uint32_t value, char separator) {
+    char digits[10];
+    uint8_t count = 0;
+    while (value > 0xFFFF) {
+        uint32_t quotient = value / 10;
+        digits[count++] = '0' + static_cast<char>(value - quotient * 10);
+        value = quotient;
+    }
+    uint16_t low = static_cast<uint16_t>(value);
+    do {
+        uint16_t quotient = low / 10;
+        digits[count++] = '0' + static_cast<char>(low - quotient * 10);
+        low = quotient;
+    } while (low);
+    while (count) {
+        *buffer++ = digits[--count];
+    }
+    *buffer++ = separator;
+    return buffer;
+}
+
+/**
+ * @brief Converts a session timestamp to whole milliseconds for the text log.
+ * 
+ * x / 1000 == (x / 8) / 125, so timestamps up to 2^35 us (~9.5 hours) need only a
+ * 32-bit division instead of a 64-bit one; longer ones fall back to 64 bits.
+ * 
+ * @param timestamp Session timestamp (us).
+ * @return Timestamp (ms), truncated to 32 bits as in the original log.
+ */
+static uint32_t toMillis(uint64_t timestamp) {
+    uint64_t eighths = timestamp >> 3;
+    if (eighths <= 0xFFFFFFFFULL) {
+        return static_cast<uint32_t>(eighths) / 125;
+    }
+    return static_cast<uint32_t>(timestamp / 1000);
+}
+
+/**
+ * @brief Formats an event in the current event format.
+ * 
+ * TEXT_FORMAT reproduces the original CSV lines, with timestamps in milliseconds
+ * (frames and drop reports carry a single value); BINARY_FORMAT produces one
+ * delimited, COBS-encoded frame.
+ * 
+ * @param event Event to format.
+ * @param buffer Output buffer of at least EVENT_LINE_SIZE bytes.
+ * @return Number of bytes to transmit.
+ */
+size_t formatEvent(const EventRecord& event, uint8_t* buffer) {
+    if (eventFormat == BINARY_FORMAT) {
+        return encodeEventFrame(event, buffer);
+    }
+    char* start = reinterpret_cast<char*>(buffer);
+    char* text = appendLabel(start, sourceLabel(event.source));
+    *text++ = ',';
+    if (event.type != EVENT_FRAME) {
+        text = appendLabel(text, actionLabel(event));
+        *text++ = ',';
+    }
+    if (event.type == EVENT_DROPPED) {
+        text = appendNumber(text, static_cast<uint32_t>(event.start), '\r');
+    } else if (event.type == EVENT_FRAME) {
+        text = appendNumber(text, toMillis(event.start), '\r');
+    } else {
+        text = appendNumber(text, toMillis(event.start), ',');
+        text = appendNumber(text, toMillis(event.end), '\r');
+    }
+    *text++ = '\n';
+    return text - start;
+}
+
+/**
+ * @brief Queues an event for transmission.
+ * 
+ * Safe to call from anywhere in loop(); if the queue is full the event is
+ * dropped and counted rather than blocking.
+ * 
+ * @param event Event to queue.
+ */
+void logEvent(const EventRecord& event) {
+    QueuedEvent queued = {event.type, event.source, event.detail, static_cast<uint32_t>(event.start),
+                          static_cast<uint32_t>(event.end)};
+    eventQueue.push(queued);
+}
+
+/**
+ * @brief Builds and queues an event for transmission.
+ * 
+ * @param type EVENT_TYPE of the event.
+ * @param source EVENT_SOURCE of the event.
+ * @param detail EVENT_DETAIL of the event.
+ * @param start Start timestamp, adjusted to program start (us).
+ * @param end End timestamp, adjusted to program start (us).
+ */
+void logEvent(EVENT_TYPE type, EVENT_SOURCE source, EVENT_DETAIL detail, uint64_t start, uint64_t end) {
+    EventRecord event = {type, source, detail, start, end};
+    logEvent(event);
+}
+
+/**
+ * @brief Restores the full session timestamps of a queued event.
+ * 
+ * The end is taken as the 64-bit time nearest the current session time with the
+ * same low 32 bits, since it may still lie ahead (a scheduled infusion end), and
+ * the start as the latest such time not after the end. Frame numbers and drop
+ * counts are not timestamps and are copied as they are.
+ * 
+ * @param queued Event from the queue.
+ * @return Event with 64-bit timestamps.
+ */
+static EventRecord widenEvent(const QueuedEvent& queued) {
+    EventRecord event = {queued.type, queued.source, queued.detail, queued.start, queued.end};
+    if (queued.type == EVENT_DROPPED) {
+        return event;
+    }
+    uint64_t now = sessionMicros(timebaseMicros());
+    if (queued.type == EVENT_FRAME) {
+        event.start = now - static_cast<uint32_t>(static_cast<uint32_t>(now) - queued.start);
+        return event;
+    }
+    int32_t ahead = static_cast<int32_t>(queued.end - static_cast<uint32_t>(now));
+    event.end = static_cast<uint64_t>(static_cast<int64_t>(now) + ahead);
+    event.start = event.end - static_cast<uint32_t>(queued.end - queued.start);
+    return event;
+}
+
+/**
+ * @brief Formats the next record to send into the pending buffer.
+ * 
+ * A change in the dropped-record total takes priority so that losses are
+ * reported as soon as the serial port has room.
+ * 
+ * @return True if a record is pending transmission.
+ */
+static bool preparePending() {
+    if (pendingLength) {
+        return true;
+    }
+    uint16_t drops = eventQueue.getDropped();
+    EventRecord event;
+    QueuedEvent queued;
+    if (drops != reportedDrops) {
+        reportedDrops = drops;
+        event = {EVENT_DROPPED, SOURCE_EVENT_QUEUE, DETAIL_NONE, drops, drops};
+    } else if (eventQueue.pop(queued)) {
+        event = widenEvent(queued);
+    } else {
+        return false;
+    }
+    pendingLength = formatEvent(event, pendingBytes);
+    return true;
+}
+
+/**
+ * @brief Writes queued events without blocking on a full serial TX buffer.
+ * 
+ * Sends whole records only, and only while Serial.availableForWrite() has room
+ * for them, so a slow host never stalls lever, lick or laser handling.
+ */
+void drainEvents() {
+    while (preparePending() && static_cast<size_t>(Serial.availableForWrite()) >= pendingLength) {
+        Serial.write(pendingBytes, pendingLength);
+        pendingLength = 0;
+    }
+}
+
+/**
+ * @brief Writes every queued event, blocking until all are sent.
+ * 
+ * Used before session boundaries so no events trail the program end banner.
+ */
+void flushEvents() {
+    while (preparePending()) {
+        Serial.write(pendingBytes, pendingLength);
+        pendingLength = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#ifndef EVENT_UTILS_H
+#define EVENT_UTILS_H
+
+#include <Arduino.h>
+#include "RingBuffer.h"
+
+/**
+ * @file Event_Utils.h
+ * @brief Event records and the text/binary formats used to send them over serial.
+ * 
+ * Every behavioral event is described by a fixed-size EventRecord. In TEXT_FORMAT
+ * (the default) a record is printed as the familiar CSV line, e.g.
+ * "RH_LEVER,ACTIVE_PRESS,100,150", with timestamps in milliseconds. In
+ * BINARY_FORMAT the record is packed into 19 little-endian bytes (type, source,
+ * detail, start, end) with timestamps in microseconds, followed by a
+ * CRC-16/CCITT-FALSE over those bytes (little-endian), COBS-encoded and
+ * wrapped in 0x00 delimiters:
+ * 
+ *     0x00 | COBS(type source detail start[8] end[8] crc[2]) | 0x00
+ * 
+ * Non-event output (pings, arm/disarm messages, setup JSON) stays plain text and
+ * never contains 0x00, so a host can tell the two apart by the delimiters.
+ * 
+ * Producers never touch Serial: logEvent() only enqueues the record, and
+ * drainEvents() writes queued records from loop() as space frees up in the
+ * serial TX buffer. Records rejected by a full queue are counted and reported
+ * as "EVENT_QUEUE,DROPPED,<total>".
+ * 
+ * The queue holds QueuedEvent, which keeps only the low 32 bits of each session
+ * timestamp to save SRAM. drainEvents() widens them back to 64 bits against the
+ * current session time, which is exact while an event is logged within about 35
+ * minutes of its end and its start lies less than 71 minutes before its end.
+ * 
+ * Frame events carry the frame number in their end field (binary only; the text
+ * line keeps its single timestamp).
+ */
+
+/**
+ * @enum EVENT_FORMAT
+ * @brief Defines how events are written to serial.
+ */
+enum EVENT_FORMAT { TEXT_FORMAT,  ///< Human-readable CSV lines (default).
+                    BINARY_FORMAT ///< COBS-framed binary records with CRC.
+};
+
+/**
+ * @enum EVENT_TYPE
+ * @brief Defines the kinds of events that can be logged.
+ */
+enum EVENT_TYPE : uint8_t { EVENT_LEVER_PRESS = 1, ///< Lever press and release.
+                            EVENT_INFUSION = 2,    ///< Pump infusion period.
+                            EVENT_STIM = 3,        ///< Laser stimulation period.
+                            EVENT_LICK = 4,        ///< Lick touch and release.
+                            EVENT_FRAME = 5,       ///< Imaging frame timestamp.
+                            EVENT_DROPPED = 6,     ///< Running total of records lost to a full queue.
+                            EVENT_BREAKPOINT = 7   ///< Progressive-ratio breakpoint, from the last reward to its detection.
+};
+
+/**
+ * @enum EVENT_SOURCE
+ * @brief Defines the device that produced an event.
+ */
+enum EVENT_SOURCE : uint8_t { SOURCE_RH_LEVER = 1,     ///< Right-hand lever.
+                              SOURCE_LH_LEVER = 2,     ///< Left-hand lever.
+                              SOURCE_PUMP = 3,         ///< Pump.
+                              SOURCE_LASER = 4,        ///< Laser.
+                              SOURCE_LICK_CIRCUIT = 5, ///< Lick circuit.
+                              SOURCE_FRAME = 6,        ///< Frame timestamp trigger.
+                              SOURCE_EVENT_QUEUE = 7   ///< Event queue itself.
+};
+
+/**
+ * @enum EVENT_DETAIL
+ * @brief Defines the press classification carried by lever press events.
+ */
+enum EVENT_DETAIL : uint8_t { DETAIL_NONE = 0,         ///< No additional detail.
+                              DETAIL_ACTIVE = 1,       ///< "ACTIVE" press.
+                              DETAIL_INACTIVE = 2,     ///< "INACTIVE" press.
+                              DETAIL_TIMEOUT = 3,      ///< "TIMEOUT" press.
+                              DETAIL_NO_CONDITION = 4  ///< "NO CONDITION" press.
+};
+
+/**
+ * @struct EventRecord
+ * @brief Fixed-size description of a single logged event.
+ */
+struct EventRecord {
+    uint8_t type;   ///< EVENT_TYPE of the event.
+    uint8_t source; ///< EVENT_SOURCE that produced the event.
+    uint8_t detail; ///< EVENT_DETAIL of the event.
+    uint64_t start; ///< Start timestamp, adjusted to program start (us).
+    uint64_t end;   ///< End timestamp, adjusted to program start (us), or frame number.
+};
+
+/**
+ * @struct QueuedEvent
+ * @brief An EventRecord as held in the event queue, with 32-bit timestamps.
+ */
+struct QueuedEvent {
+    uint8_t type;   ///< EVENT_TYPE of the event.
+    uint8_t source; ///< EVENT_SOURCE that produced the event.
+    uint8_t detail; ///< EVENT_DETAIL of the event.
+    uint32_t start; ///< Low 32 bits of the start timestamp (us), or a count.
+    uint32_t end;   ///< Low 32 bits of the end timestamp (us), or frame number or count.
+};
+
+const size_t EVENT_PAYLOAD_SIZE = 19;                         ///< Packed record size (bytes).
+const size_t EVENT_FRAME_SIZE = EVENT_PAYLOAD_SIZE + 2 + 1 + 2; ///< Worst-case framed size (bytes).
+const size_t EVENT_LINE_SIZE = 56;                            ///< Longest text line, including CR/LF (bytes).
+
+typedef RingBuffer<QueuedEvent, 32> EventQueue; ///< Events produced by loop().
+
+/**
+ * @brief Computes a CRC-16/CCITT-FALSE checksum.
+ * @param data Bytes to checksum.
+ * @param length Number of bytes.
+ * @return The 16-bit checksum.
+ */
+uint16_t crc16(const uint8_t* data, size_t length);
+
+/**
+ * @brief COBS-encodes a buffer so that it contains no zero bytes.
+ * @param data Bytes to encode (at most 254).
+ * @param length Number of bytes.
+ * @param encoded Output buffer of at least length + 1 bytes.
+ * @return Number of encoded bytes.
+ */
+size_t cobsEncode(const uint8_t* data, size_t length, uint8_t* encoded);
+
+/**
+ * @brief Builds a delimited binary frame for an event.
+ * @param event Event to encode.
+ * @param frame Output buffer of at least EVENT_FRAME_SIZE bytes.
+ * @return Number of bytes in the frame.
+ */
+size_t encodeEventFrame(const EventRecord& event, uint8_t* frame);
+
+/**
+ * @brief Formats an event in the current event format.
+ * @param event Event to format.
+ * @param buffer Output buffer of at least EVENT_LINE_SIZE bytes.
+ * @return Number of bytes to transmit.
+ */
+size_t formatEvent(const EventRecord& event, uint8_t* buffer);
+
+/**
+ * @brief Queues an event for transmission.
+ * @param event Event to queue.
+ */
+void logEvent(const EventRecord& event);
+
+/**
+ * @brief Builds and queues an event for transmission.
+ * @param type EVENT_TYPE of the event.
+ * @param source EVENT_SOURCE of the event.
+ * @param detail EVENT_DETAIL of the event.
+ * @param start Start timestamp, adjusted to program start (us).
+ * @param end End timestamp, adjusted to program start (us).
+ */
+void logEvent(EVENT_TYPE type, EVENT_SOURCE source, EVENT_DETAIL detail, uint64_t start, uint64_t end);
+
+/**
+ * @brief Writes queued events without blocking on a full serial TX buffer.
+ */
+void drainEvents();
+
+/**
+ * @brief Writes every queued event, blocking until all are sent.
+ */
+void flushEvents();
+
+#endif // EVENT_UTILS_H
\ No newline at end of file
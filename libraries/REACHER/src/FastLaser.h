@@ -0,0 +1,48 @@
+#ifndef FAST_LASER_H
+#define FAST_LASER_H
+
+#include "Laser.h"
+#include "FastPin.h"
+
+/**
+ * @file FastLaser.h
+ * @brief Defines FastLaser, a Laser bound to a compile-time pin.
+ */
+
+/**
+ * @class FastLaser
+ * @brief A Laser that drives PIN with direct port writes.
+ *
+ * Behaves exactly like Laser(PIN). on() and off() hide Laser's with versions that write
+ * FastPin<PIN>, so on an ATmega328P each switch is one sbi or cbi with no virtual call.
+ * They are picked by the static type: through a Laser* or Laser& the Laser versions
+ * run and use digitalWrite(). The session calls them on its FastLaser directly.
+ */
+template <uint8_t PIN>
+class FastLaser : public Laser {
+public:
+    /**
+     * @brief Constructor for the FastLaser class.
+     */
+    FastLaser() : Laser(PIN) {}
+
+    /**
+     * @brief Turns the laser on with a direct port write, if it is off. A running pulse train is stopped first.
+     */
+    void on() {
+        if (switchOutput(true)) {
+            FastPin<PIN>::high();
+        }
+    }
+
+    /**
+     * @brief Turns the laser off with a direct port write, if it is on.
+     */
+    void off() {
+        if (switchOutput(false)) {
+            FastPin<PIN>::low();
+        }
+    }
+};
+
+#endif // FAST_LASER_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+#ifndef FAST_PIN_H
+#define FAST_PIN_H
+
+#include <Arduino.h>
+
+/**
+ * @file FastPin.h
+ * @brief Digital pin I/O bound to a pin number at compile time.
+ *
+ * digitalWrite() and digitalRead() look the pin up in three PROGMEM tables, check for
+ * a PWM timer and disable interrupts around a read-modify-write on every call. With the
+ * pin known at compile time, FastPin<PIN> resolves the PORTx/PINx/DDRx register and bit
+ * mask in the compiler, so high(), low() and toggle() become a single sbi/cbi/out and
+ * read() a single sbis/sbic on the ATmega328P. On other targets, including the host
+ * build, it falls back to the Arduino calls.
+ *
+ * FastPin does not turn off a PWM output on the pin the way digitalWrite() does; it is
+ * meant for pins that are never driven with analogWrite().
+ */
+
+#if defined(__AVR_ATmega328P__)
+#define FAST_PIN_PORTS ///< Pins map to PORTB/C/D; access the registers directly.
+#endif
+
+/**
+ * @class FastPin
+ * @brief Static I/O on the compile-time digital pin PIN.
+ */
+template <uint8_t PIN>
+class FastPin {
+#if defined(FAST_PIN_PORTS)
+    static_assert(PIN < 20, "FastPin: the ATmega328P has digital pins 0-19");
+
+    static constexpr uint8_t MASK = 1 << (PIN < 8 ? PIN : PIN < 14 ? PIN - 8 : PIN - 14); ///< Bit of the pin in its port.
+
+    /**
+     * @brief Gets the output register of the pin.
+     * @return PORTD for pins 0-7, PORTB for 8-13, PORTC for 14-19.
+     */
+    __attribute__((always_inline)) static inline volatile uint8_t& outputRegister() {
+        return PIN < 8 ? PORTD : PIN < 14 ? PORTB : PORTC;
+    }
+
+    /**
+     * @brief Gets the input register of the pin.
+     * @return PIND for pins 0-7, PINB for 8-13, PINC for 14-19.
+     */
+    __attribute__((always_inline)) static inline volatile uint8_t& inputRegister() {
+        return PIN < 8 ? PIND : PIN < 14 ? PINB : PINC;
+    }
+
+    /**
+     * @brief Gets the data direction register of the pin.
+     * @return DDRD for pins 0-7, DDRB for 8-13, DDRC for 14-19.
+     */
+    __attribute__((always_inline)) static inline volatile uint8_t& directionRegister() {
+        return PIN < 8 ? DDRD : PIN < 14 ? DDRB : DDRC;
+    }
+#endif
+
+public:
+    static constexpr uint8_t pin = PIN; ///< Digital pin number.
+
+    /**
+     * @brief Configures the pin as an output.
+     */
+    static inline void output() {
+#if defined(FAST_PIN_PORTS)
+        directionRegister() |= MASK;
+#else
+        pinMode(PIN, OUTPUT);
+#endif
+    }
+
+    /**
+     * @brief Drives the pin high.
+     */
+    static inline void high() {
+#if defined(FAST_PIN_PORTS)
+        outputRegister() |= MASK;
+#else
+        digitalWrite(PIN, HIGH);
+#endif
+    }
+
+    /**
+     * @brief Drives the pin low.
+     */
+    static inline void low() {
+#if defined(FAST_PIN_PORTS)
+        outputRegister() &= ~MASK;
+#else
+        digitalWrite(PIN, LOW);
+#endif
+    }
+
+    /**
+     * @brief Drives the pin to a level.
+     * @param level True for high, false for low.
+     */
+    static inline void write(bool level) {
+        if (level) {
+            high();
+        } else {
+            low();
+        }
+    }
+
+    /**
+     * @brief Inverts the pin's output level.
+     *
+     * On the ATmega328P writing a 1 to PINx toggles the output, so this is one
+     * instruction with no read-modify-write.
+     */
+    static inline void toggle() {
+#if defined(FAST_PIN_PORTS)
+        inputRegister() = MASK;
+#else
+        digitalWrite(PIN, digitalRead(PIN) == HIGH ? LOW : HIGH);
+#endif
+    }
+
+    /**
+     * @brief Reads the pin.
+     * @return True if the pin is high.
+     */
+    static inline bool read() {
+#if defined(FAST_PIN_PORTS)
+        return (inputRegister() & MASK) != 0;
+#else
+        return digitalRead(PIN) == HIGH;
+#endif
+    }
+};
+
+#endif // FAST_PIN_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef FAST_PUMP_H
+#define FAST_PUMP_H
+
+#include "Pump.h"
+#include "FastPin.h"
+
+/**
+ * @file FastPump.h
+ * @brief Defines FastPump, a Pump bound to a compile-time pin.
+ */
+
+/**
+ * @class FastPump
+ * @brief A Pump that drives PIN with direct port writes.
+ *
+ * Behaves exactly like Pump(PIN). on() and off() hide Pump's with versions that write
+ * FastPin<PIN>, so on an ATmega328P each switch is one sbi or cbi with no virtual call.
+ * They are picked by the static type: through a Pump* or Pump& the Pump versions
+ * run and use digitalWrite(). Keep the FastPump type on hot paths (see managePump()).
+ */
+template <uint8_t PIN>
+class FastPump : public Pump {
+public:
+    /**
+     * @brief Constructor for the FastPump class.
+     */
+    FastPump() : Pump(PIN) {}
+
+    /**
+     * @brief Turns the pump on with a direct port write, if it is off.
+     */
+    void on() {
+        if (switchOutput(true)) {
+            FastPin<PIN>::high();
+        }
+    }
+
+    /**
+     * @brief Turns the pump off with a direct port write, if it is on.
+     */
+    void off() {
+        if (switchOutput(false)) {
+            FastPin<PIN>::low();
+        }
+    }
+};
+
+#endif // FAST_PUMP_H
\ No newline at end of file
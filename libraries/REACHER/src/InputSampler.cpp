@@ -0,0 +1,178 @@
+#include "InputSampler.h"
+#include "Timebase.h"
+#include <Arduino.h>
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+#endif
+
+/**
+ * @brief Constructs an empty InputSampler.
+ */
+InputSampler::InputSampler()
+    : inputCount(0), timestamp(0)
+#if defined(__AVR__)
+      , portCount(0)
+#else
+      , levels(0)
+#endif
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+      , feedCount(0), debounceStarted(false)
+#endif
+{}
+
+/**
+ * @brief Registers a pin to be read on every snapshot.
+ *
+ * On AVR the pin's PINx register and bit mask are resolved once here, and pins
+ * sharing a port share a single register read.
+ *
+ * @param pin Digital pin, already configured as an input.
+ * @return True if registered, false if the sampler is full.
+ */
+bool InputSampler::addInput(byte pin) {
+    if (inputCount >= MAX_SAMPLED_INPUTS) {
+        return false;
+    }
+#if defined(__AVR__)
+    volatile uint8_t* port = portInputRegister(digitalPinToPort(pin));
+    uint8_t portIndex = 0;
+    while (portIndex < portCount && ports[portIndex] != port) {
+        portIndex++;
+    }
+    if (portIndex == portCount) {
+        ports[portCount++] = port;
+    }
+    inputPorts[inputCount] = portIndex;
+    inputMasks[inputCount] = digitalPinToBitMask(pin);
+#endif
+    pins[inputCount++] = pin;
+    return true;
+}
+
+/**
+ * @brief Reads every registered pin and records the snapshot time.
+ *
+ * On AVR the port reads and the timestamp are taken with interrupts disabled,
+ * so the snapshot is consistent across ports. In vertical-counter mode the
+ * snapshot is then passed to the port debouncers.
+ */
+void InputSampler::sample() {
+#if defined(__AVR__)
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < portCount; i++) {
+            portValues[i] = *ports[i];
+        }
+        timestamp = timebaseMicros();
+    }
+#else
+    levels = 0;
+    for (uint8_t i = 0; i < inputCount; i++) {
+        if (digitalRead(pins[i]) == HIGH) {
+            levels |= 1 << i;
+        }
+    }
+    timestamp = timebaseMicros();
+#endif
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+    debounce();
+#endif
+}
+
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+/**
+ * @brief Feeds the snapshot into the port debouncers when their interval is up.
+ *
+ * The first snapshot is taken as the stable state. Toggled bits are kept only
+ * until the next snapshot, so each edge is reported once.
+ */
+void InputSampler::debounce() {
+#if defined(__AVR__)
+    const uint8_t* values = portValues;
+    uint8_t count = portCount;
+#else
+    const uint8_t* values = &levels;
+    uint8_t count = 1;
+#endif
+    uint32_t now = static_cast<uint32_t>(timestamp);
+    for (uint8_t i = 0; i < count; i++) {
+        toggledBits[i] = 0;
+    }
+    if (!debounceStarted) {
+        for (uint8_t i = 0; i < count; i++) {
+            debouncers[i].reset(values[i]);
+        }
+        feedTimes[feedCount++ % 4] = now;
+        debounceStarted = true;
+    } else if (now - feedTimes[(feedCount - 1) % 4] >= VERTICAL_DEBOUNCE_INTERVAL) {
+        for (uint8_t i = 0; i < count; i++) {
+            toggledBits[i] = debouncers[i].update(values[i]);
+        }
+        feedTimes[feedCount++ % 4] = now;
+    }
+}
+#endif
+
+/**
+ * @brief Gets a pin's level from the last snapshot.
+ *
+ * @param pin Digital pin.
+ * @return HIGH or LOW; unregistered pins are read directly.
+ */
+bool InputSampler::read(byte pin) const {
+    for (uint8_t i = 0; i < inputCount; i++) {
+        if (pins[i] == pin) {
+#if defined(__AVR__)
+            return (portValues[inputPorts[i]] & inputMasks[i]) ? HIGH : LOW;
+#else
+            return (levels & (1 << i)) ? HIGH : LOW;
+#endif
+        }
+    }
+    return digitalRead(pin);
+}
+
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+/**
+ * @brief Gets a pin's debounced transition at the last snapshot.
+ *
+ * @param pin Registered digital pin.
+ * @return EDGE_RISE or EDGE_FALL if the pin's debounced level changed, otherwise EDGE_NONE.
+ */
+EDGE InputSampler::edge(byte pin) const {
+    for (uint8_t i = 0; i < inputCount; i++) {
+        if (pins[i] == pin) {
+#if defined(__AVR__)
+            uint8_t port = inputPorts[i];
+            uint8_t mask = inputMasks[i];
+#else
+            uint8_t port = 0;
+            uint8_t mask = 1 << i;
+#endif
+            if (!(toggledBits[port] & mask)) {
+                return EDGE_NONE;
+            }
+            return (debouncers[port].getStableBits() & mask) ? EDGE_RISE : EDGE_FALL;
+        }
+    }
+    return EDGE_NONE;
+}
+
+/**
+ * @brief Gets the time of the edges reported at the last snapshot.
+ *
+ * @return Time of the debouncer sample three before the latest (low 32 bits of the timebase, us).
+ */
+uint32_t InputSampler::getEdgeTime() const {
+    return feedTimes[feedCount % 4];
+}
+#endif
+
+/**
+ * @brief Gets the time of the last snapshot.
+ *
+ * @return Timebase timestamp (us).
+ */
+uint64_t InputSampler::getTimestamp() const {
+    return timestamp;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef INPUT_SAMPLER_H
+#define INPUT_SAMPLER_H
+
+#include <Arduino.h>
+#include "Debouncer.h"
+
+/**
+ * @file InputSampler.h
+ * @brief Defines the InputSampler class for reading all input devices in one snapshot.
+ *
+ * On AVR boards the sampler groups registered pins by port and reads each PINx
+ * register once per snapshot, with interrupts disabled, together with a single
+ * timebase timestamp. Inputs that change together are therefore seen together
+ * and share one timestamp. On other targets (including host builds) it falls
+ * back to digitalRead(), so the same code compiles and runs off-target.
+ *
+ * With INPUT_SAMPLER_VERTICAL_DEBOUNCE defined, the snapshot also feeds one
+ * PortDebouncer per port every VERTICAL_DEBOUNCE_INTERVAL, debouncing every
+ * registered pin in parallel, and the levers and lick circuit take their edges
+ * from edge() instead of their own Debouncer. A level must then hold for four
+ * debouncer samples (15-20 ms) on every input, and the SET_DEBOUNCE_ commands
+ * have no effect. Edges are dated by the first of the four samples, so bounce
+ * longer than an interval delays the logged time by up to its length.
+ */
+
+// #define INPUT_SAMPLER_VERTICAL_DEBOUNCE ///< Uncomment to debounce all inputs from the port snapshot.
+
+const uint8_t MAX_SAMPLED_INPUTS = 4; ///< Maximum number of pins an InputSampler can hold.
+
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+const uint32_t VERTICAL_DEBOUNCE_INTERVAL = 5000; ///< Time between samples fed to the port debouncers (us).
+#endif
+
+/**
+ * @class InputSampler
+ * @brief Snapshots the levels of a fixed set of input pins.
+ */
+class InputSampler {
+private:
+    byte pins[MAX_SAMPLED_INPUTS];        ///< Registered pins.
+    uint8_t inputCount;                   ///< Number of registered pins.
+    uint64_t timestamp;                   ///< Time of the last snapshot (us).
+#if defined(__AVR__)
+    volatile uint8_t* ports[MAX_SAMPLED_INPUTS]; ///< Distinct PINx registers to read.
+    uint8_t portValues[MAX_SAMPLED_INPUTS];      ///< PINx values at the last snapshot.
+    uint8_t portCount;                           ///< Number of distinct PINx registers.
+    uint8_t inputPorts[MAX_SAMPLED_INPUTS];      ///< Index into ports for each pin.
+    uint8_t inputMasks[MAX_SAMPLED_INPUTS];      ///< Bit mask of each pin within its port.
+#else
+    uint8_t levels;                              ///< Bit i holds the level of pins[i].
+#endif
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+    PortDebouncer debouncers[MAX_SAMPLED_INPUTS]; ///< One per port (one for levels off-AVR).
+    uint8_t toggledBits[MAX_SAMPLED_INPUTS];      ///< Bits each debouncer toggled at the last snapshot.
+    uint32_t feedTimes[4];                        ///< Low 32 bits of the last four debouncer sample times (us).
+    uint8_t feedCount;                            ///< Debouncer samples taken; the latest is feedTimes[(feedCount - 1) % 4].
+    bool debounceStarted;                         ///< Whether the debouncers hold a snapshot yet.
+
+    /**
+     * @brief Feeds the snapshot into the port debouncers when their interval is up.
+     */
+    void debounce();
+#endif
+
+public:
+    /**
+     * @brief Constructor for the InputSampler class.
+     */
+    InputSampler();
+
+    /**
+     * @brief Registers a pin to be read on every snapshot.
+     * @param pin Digital pin, already configured as an input.
+     * @return True if registered, false if the sampler is full.
+     */
+    bool addInput(byte pin);
+
+    /**
+     * @brief Reads every registered pin and records the snapshot time.
+     */
+    void sample();
+
+    /**
+     * @brief Gets a pin's level from the last snapshot.
+     *
+     * Pins that were never registered are read directly.
+     *
+     * @param pin Digital pin.
+     * @return HIGH or LOW.
+     */
+    bool read(byte pin) const;
+
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+    /**
+     * @brief Gets a pin's debounced transition at the last snapshot.
+     * @param pin Registered digital pin.
+     * @return EDGE_RISE or EDGE_FALL if the pin's debounced level changed, otherwise EDGE_NONE.
+     */
+    EDGE edge(byte pin) const;
+
+    /**
+     * @brief Gets the time of the edges reported at the last snapshot.
+     *
+     * A bit toggles on its fourth differing debouncer sample, so every edge
+     * reported together is dated by the debouncer sample three before.
+     *
+     * @return Time of the first differing debouncer sample (low 32 bits of the timebase, us).
+     */
+    uint32_t getEdgeTime() const;
+#endif
+
+    /**
+     * @brief Gets the time of the last snapshot.
+     * @return Timebase timestamp (us).
+     */
+    uint64_t getTimestamp() const;
+};
+
+#endif // INPUT_SAMPLER_H
\ No newline at end of file
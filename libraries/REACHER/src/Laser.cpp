@@ -0,0 +1,456 @@
+#include "Laser.h"
+
+/**
+ * @brief Constructs a Laser object with an initial pin and default settings.
+ * 
+ * Initializes a Laser object as a subclass of Device, setting the pin and default
+ * values for stimulation duration, frequency, timing, and state variables.
+ * 
+ * @param initPin The digital pin (byte) to which the laser is connected.
+ */
+Laser::Laser(byte initPin) 
+    : Device(initPin), duration(30000), frequency(20), stimStart(0), stimEnd(0), 
+      pulseWidth(0), trainCredited(0), waveform(), logged(true), cycleUp(false), 
+      cycleEpochs(0), lateCycles(0), maxCycleLag(0), laserMode(CYCLE), laserState(INACTIVE), laserAction(OFF), outputOn(false) {}
+
+/**
+ * @brief Sets the stimulation duration in milliseconds.
+ * 
+ * Converts the input duration from seconds to milliseconds.
+ * 
+ * @param initDuration Duration in seconds to set for the stimulation period.
+ */
+void Laser::setDuration(uint32_t initDuration) {
+    duration = initDuration * 1000;
+}
+
+/**
+ * @brief Sets the frequency of the laser pulses.
+ * 
+ * @param initFrequency Frequency in Hz to set for the laser pulses.
+ */
+void Laser::setFrequency(uint32_t initFrequency) {
+    frequency = initFrequency;
+}
+
+/**
+ * @brief Sets the stimulation period start and end times.
+ * 
+ * @param currentMillis Current time in milliseconds to base the period on.
+ */
+void Laser::setStimPeriod(uint32_t currentMillis) {
+    stimStart = currentMillis;
+    stimEnd = currentMillis + duration;
+}
+
+/**
+ * @brief Sets the width of each laser pulse.
+ * 
+ * @param initWidth Width in microseconds, or 0 for a 50% duty cycle.
+ */
+void Laser::setPulseWidth(uint32_t initWidth) {
+    pulseWidth = initWidth;
+}
+
+/**
+ * @brief Sets the logged state of the stimulation event.
+ * 
+ * @param log Boolean indicating if the stimulation has been logged.
+ */
+void Laser::setStimLogged(bool log) {
+    logged = log;
+}
+
+/**
+ * @brief Sets the cycle-up state for stimulation cycling.
+ * 
+ * @param cycle Boolean indicating if the laser is in the active cycle phase.
+ */
+void Laser::setCycleUp(bool cycle) {
+    cycleUp = cycle;
+}
+
+/**
+ * @brief Sets the stimulation mode (CYCLE or ACTIVE_PRESS).
+ * 
+ * Switching to CYCLE clears the stimulation period, so manageStim() lays the schedule
+ * on the program start again instead of keeping a period set by an active press.
+ * 
+ * @param mode The MODE enum value to set (CYCLE or ACTIVE_PRESS).
+ */
+void Laser::setStimMode(MODE mode) {
+    if (mode == CYCLE && laserMode != CYCLE) {
+        stimStart = 0;
+        stimEnd = 0;
+    }
+    laserMode = mode;
+}
+
+/**
+ * @brief Sets the stimulation state (ACTIVE or INACTIVE).
+ * 
+ * @param state The STATE enum value to set (ACTIVE or INACTIVE).
+ */
+void Laser::setStimState(STATE state) {
+    laserState = state;
+}
+
+/**
+ * @brief Starts the CYCLE schedule on an anchor and clears its lag statistics.
+ * 
+ * Epoch k runs from anchorMillis + k * duration and even epochs are ON, so a laser
+ * armed after the anchor joins the schedule in the epoch it would have reached.
+ * 
+ * @param anchorMillis Start of epoch 0 (ms).
+ * @param currentMillis Current time in milliseconds.
+ */
+void Laser::startCycle(uint32_t anchorMillis, uint32_t currentMillis) {
+    uint32_t epoch = duration && currentMillis > anchorMillis ? (currentMillis - anchorMillis) / duration : 0;
+    stimStart = anchorMillis + epoch * duration;
+    stimEnd = stimStart + duration;
+    cycleUp = epoch % 2 == 0;
+    cycleEpochs = 0;
+    lateCycles = 0;
+    maxCycleLag = 0;
+}
+
+/**
+ * @brief Moves the CYCLE schedule on to the epoch containing the current time.
+ * 
+ * Epochs passed over entirely are skipped in pairs or with a phase change, so the ON
+ * and OFF phases stay on their absolute slots. Divides only at epoch boundaries.
+ * 
+ * @param currentMillis Current time in milliseconds, at or after the end of the period.
+ */
+void Laser::advanceCycle(uint32_t currentMillis) {
+    if (duration == 0) { // Zero-length epochs cannot be anchored; nothing is stimulated
+        setStimPeriod(currentMillis);
+        cycleUp = !cycleUp;
+        return;
+    }
+    uint32_t lag = currentMillis - stimEnd;
+    uint32_t skipped = lag / duration;
+    stimStart = stimEnd + skipped * duration;
+    stimEnd = stimStart + duration;
+    if (skipped % 2 == 0) {
+        cycleUp = !cycleUp;
+    }
+    cycleEpochs += skipped + 1;
+    if (lag > 0) {
+        lateCycles++;
+        if (lag > maxCycleLag) {
+            maxCycleLag = lag;
+        }
+    }
+}
+
+/**
+ * @brief Sets the laser action (ON or OFF).
+ * 
+ * @param action The ACTION enum value to set (ON or OFF).
+ */
+void Laser::setStimAction(ACTION action) {
+    laserAction = action;
+}
+
+/**
+ * @brief Retrieves the stimulation duration.
+ * 
+ * @return Duration in milliseconds.
+ */
+uint32_t Laser::getDuration() {
+    return duration;
+}
+
+/**
+ * @brief Retrieves the laser pulse frequency.
+ * 
+ * @return Frequency in Hz.
+ */
+uint32_t Laser::getFrequency() {
+    return frequency;
+}
+
+/**
+ * @brief Retrieves the stimulation start time.
+ * 
+ * @return Start time in milliseconds.
+ */
+uint32_t Laser::getStimStart() {
+    return stimStart;
+}
+
+/**
+ * @brief Retrieves the stimulation end time.
+ * 
+ * @return End time in milliseconds.
+ */
+uint32_t Laser::getStimEnd() {
+    return stimEnd;
+}
+
+/**
+ * @brief Retrieves the pulse width as set.
+ * 
+ * @return Width in microseconds, or 0 for half the period.
+ */
+uint32_t Laser::getPulseWidth() {
+    return pulseWidth;
+}
+
+/**
+ * @brief Retrieves the width each pulse is generated with.
+ * 
+ * At 1 Hz the laser stays on for the whole stimulation period, so each pulse fills
+ * its period; otherwise a width of 0 gives a 50% duty cycle.
+ * 
+ * @return Width in microseconds.
+ */
+uint32_t Laser::getEffectivePulseWidth() {
+    if (frequency == 1) {
+        return 1000000 / getTrainFrequency();
+    }
+    return pulseWidth ? pulseWidth : 500000 / frequency;
+}
+
+/**
+ * @brief Retrieves the frequency the pulse train is generated at.
+ * 
+ * Constant stimulation (1 Hz) runs as gapless 1 ms pulses, so the train can be
+ * started and lengthened to the millisecond.
+ * 
+ * @return Pulses per second (Hz).
+ */
+uint32_t Laser::getTrainFrequency() {
+    return frequency == 1 ? 1000 : frequency;
+}
+
+/**
+ * @brief Retrieves the pulse train played for a stimulation period without a waveform.
+ * 
+ * Holds as many pulses at the train frequency as fit in the period, and at least one.
+ * 
+ * @param trainDuration Length of the stimulation period (ms).
+ * @return Waveform of a single burst.
+ */
+Waveform Laser::getPulseTrain(uint32_t trainDuration) {
+    uint32_t rate = getTrainFrequency();
+    uint32_t pulses = static_cast<uint32_t>(static_cast<uint64_t>(trainDuration) * rate / 1000);
+    Waveform train = {rate, getEffectivePulseWidth(), pulses ? pulses : 1, 0, 1, 0, 1, RAMP_NONE, 0};
+    return train;
+}
+
+/**
+ * @brief Checks if the stimulation has been logged.
+ * 
+ * @return Boolean indicating logged state.
+ */
+bool Laser::getStimLog() {
+    return logged;
+}
+
+/**
+ * @brief Checks if the laser is in the active cycle phase.
+ * 
+ * @return Boolean indicating cycle-up state.
+ */
+bool Laser::getCycleUp() {
+    return cycleUp;
+}
+
+/**
+ * @brief Retrieves the number of CYCLE epochs ended since the cycle started.
+ * 
+ * @return Epochs, including any passed over entirely.
+ */
+uint32_t Laser::getCycleEpochs() {
+    return cycleEpochs;
+}
+
+/**
+ * @brief Retrieves the number of CYCLE epochs whose end was noticed late.
+ * 
+ * @return Late epochs.
+ */
+uint32_t Laser::getLateCycles() {
+    return lateCycles;
+}
+
+/**
+ * @brief Retrieves the longest delay in noticing the end of a CYCLE epoch.
+ * 
+ * @return Delay in milliseconds.
+ */
+uint32_t Laser::getMaxCycleLag() {
+    return maxCycleLag;
+}
+
+/**
+ * @brief Retrieves the current stimulation mode.
+ * 
+ * @return MODE enum value (CYCLE or ACTIVE_PRESS).
+ */
+MODE Laser::getStimMode() {
+    return laserMode;
+}
+
+/**
+ * @brief Retrieves the current stimulation state.
+ * 
+ * @return STATE enum value (ACTIVE or INACTIVE).
+ */
+STATE Laser::getStimState() {
+    return laserState;
+}
+
+/**
+ * @brief Retrieves the current laser action.
+ * 
+ * @return ACTION enum value (ON or OFF).
+ */
+ACTION Laser::getStimAction() {
+    return laserAction;
+}
+
+/**
+ * @brief Starts the pulse train for one stimulation period.
+ * 
+ * The train runs for the stimulation duration on its own clock, so its last edge does
+ * not depend on when the loop notices the period has ended. The pin is driven low
+ * first, so the engine takes it over from a known level and leaves it low.
+ * 
+ * @param currentMillis Current time in milliseconds.
+ * @return Boolean indicating the train started.
+ */
+bool Laser::startPulses(uint32_t currentMillis) {
+    off();
+    if (hasWaveform()) {
+        return pulseTrainStart(waveform);
+    }
+    trainCredited = currentMillis;
+    return pulseTrainStart(getPulseTrain(duration));
+}
+
+/**
+ * @brief Lengthens the running pulse train by the time since it was started or last extended.
+ * 
+ * Adds the whole pulses that fit in the elapsed time and carries the rest forward, so
+ * repeated extensions add up to the elapsed time exactly.
+ * 
+ * @param currentMillis Current time in milliseconds.
+ */
+void Laser::extendPulses(uint32_t currentMillis) {
+    if (!pulseTrainRunning()) {
+        return;
+    }
+    uint32_t rate = getTrainFrequency();
+    uint32_t pulses = static_cast<uint32_t>(static_cast<uint64_t>(currentMillis - trainCredited) * rate / 1000);
+    trainCredited += static_cast<uint32_t>(static_cast<uint64_t>(pulses) * 1000 / rate);
+    pulseTrainExtend(pulses);
+}
+
+/**
+ * @brief Stops the pulse train and drives the pin low.
+ */
+void Laser::stopPulses() {
+    pulseTrainStop();
+}
+
+/**
+ * @brief Checks if the pulse train is running.
+ * 
+ * @return Boolean indicating the train is running.
+ */
+bool Laser::isPulsing() {
+    return pulseTrainRunning();
+}
+
+/**
+ * @brief Takes the oldest completed train of the waveform.
+ * 
+ * @param start Set to the time of its first rising edge on the timebase clock (us).
+ * @param end Set to the time of its last falling edge on the timebase clock (us).
+ * @return Boolean indicating a train was taken.
+ */
+bool Laser::nextTrain(uint64_t& start, uint64_t& end) {
+    return pulseTrainNextTrain(start, end);
+}
+
+/**
+ * @brief Loads a waveform to play in place of the frequency and pulse width.
+ * 
+ * Each stimulation period then plays the waveform from its start, cut off at the end
+ * of the period if it is still running.
+ * 
+ * @param initWaveform Waveform descriptor, checked with pulseTrainValid().
+ */
+void Laser::setWaveform(const Waveform& initWaveform) {
+    waveform = initWaveform;
+}
+
+/**
+ * @brief Returns to pulses at the frequency and pulse width for the stimulation duration.
+ */
+void Laser::clearWaveform() {
+    waveform = Waveform();
+}
+
+/**
+ * @brief Checks if a waveform is loaded.
+ * 
+ * @return Boolean indicating a waveform is loaded.
+ */
+bool Laser::hasWaveform() {
+    return waveform.pulses != 0;
+}
+
+/**
+ * @brief Retrieves the loaded waveform.
+ * 
+ * @return Reference to the waveform descriptor.
+ */
+const Waveform& Laser::getWaveform() {
+    return waveform;
+}
+
+/**
+ * @brief Records the level the laser pin is to be driven to.
+ * 
+ * Stops a running pulse train before turning the laser on; the engine writes the pin
+ * without updating outputOn, so the flag only tracks the pin while no train runs.
+ * 
+ * @param level True for high, false for low.
+ * @return Boolean indicating the level changed and the pin must be written.
+ */
+bool Laser::switchOutput(bool level) {
+    if (level && pulseTrainRunning()) {
+        stopPulses();
+    }
+    if (outputOn == level) {
+        return false;
+    }
+    outputOn = level;
+    return true;
+}
+
+/**
+ * @brief Turns the laser on by setting the pin high, if it is not already on.
+ * 
+ * Stops a running pulse train first.
+ */
+void Laser::on() {
+    if (switchOutput(true)) {
+        digitalWrite(pin, HIGH); // Turn the laser ON
+    }
+    // Serial.println("ON, " + String(laserAction) + ", " + String(cycleUp) + ", " + String(laserState)); // Uncomment for debugging
+}
+
+/**
+ * @brief Turns the laser off by setting the pin low, if it is not already off.
+ */
+void Laser::off() {
+    if (switchOutput(false)) {
+        digitalWrite(pin, LOW); // Turn the laser OFF
+    }
+    // Serial.println("OFF, " + String(laserAction) + ", " + String(cycleUp) + ", " + String(laserState)); // Uncomment for debugging
+}
\ No newline at end of file
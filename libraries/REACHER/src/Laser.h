@@ -0,0 +1,346 @@
+#ifndef LASER_H
+#define LASER_H
+
+#include "Device.h"
+#include "PulseTrain.h"
+#include <Arduino.h>
+
+/**
+ * @file Laser.h
+ * @brief Defines the Laser class for controlling a laser device.
+ * 
+ * The Laser class extends the Device class to manage a laser with stimulation
+ * periods, frequencies, and cycling behavior.
+ */
+
+/**
+ * @enum MODE
+ * @brief Defines the operating modes of the laser.
+ */
+enum MODE { CYCLE,     ///< Laser operates in oscillating cycles.
+            ACTIVE_PRESS ///< Laser is active based on external input.
+};
+
+/**
+ * @enum STATE
+ * @brief Defines the stimulation states of the laser.
+ */
+enum STATE { INACTIVE, ///< Laser is not stimulating.
+             ACTIVE    ///< Laser is actively stimulating.
+};
+
+/**
+ * @enum ACTION
+ * @brief Defines the on/off actions of the laser.
+ */
+enum ACTION { OFF, ///< Laser is turned off.
+              ON   ///< Laser is turned on.
+};
+
+/**
+ * @class Laser
+ * @brief A subclass of Device representing a laser with stimulation control.
+ * 
+ * Manages a laser connected to a digital pin, providing methods to control
+ * stimulation duration, frequency, and on/off states with cycling behavior.
+ */
+class Laser : public Device {
+private:
+    uint32_t duration;        ///< Total duration of the stimulation period (ms).
+    uint32_t frequency;       ///< Frequency of laser pulses (Hz).
+    uint32_t stimStart;       ///< Start time of the stimulation period (ms).
+    uint32_t stimEnd;         ///< End time of the stimulation period (ms).
+    uint32_t pulseWidth;      ///< Width of each pulse (us), or 0 for half the period.
+    uint32_t trainCredited;   ///< Time up to which the running pulse train has been given pulses (ms).
+    Waveform waveform;        ///< Uploaded waveform; none while its pulse count is 0.
+    bool logged;              ///< Indicates if the stimulation has been logged.
+    bool cycleUp;             ///< Indicates if the laser is in the active cycle phase.
+    uint32_t cycleEpochs;     ///< CYCLE epochs ended since the cycle started.
+    uint32_t lateCycles;      ///< CYCLE epochs whose end was noticed late.
+    uint32_t maxCycleLag;     ///< Longest delay in noticing the end of a CYCLE epoch (ms).
+    MODE laserMode;           ///< Current operating mode (CYCLE or ACTIVE_PRESS).
+    STATE laserState;         ///< Current stimulation state (ACTIVE or INACTIVE).
+    ACTION laserAction;       ///< Current laser action (ON or OFF).
+    bool outputOn;            ///< Level on() and off() last drove the pin to; false while the engine owns it.
+
+protected:
+    /**
+     * @brief Records the level the laser pin is to be driven to.
+     *
+     * Stops a running pulse train before turning the laser on, handing the pin back from
+     * the engine. on() and off(), and FastLaser's, write the pin only when this returns true.
+     *
+     * @param level True for high, false for low.
+     * @return Boolean indicating the level changed and the pin must be written.
+     */
+    bool switchOutput(bool level);
+
+public:
+    /**
+     * @brief Constructor for the Laser class.
+     * 
+     * @param initPin The digital pin to which the laser is connected.
+     */
+    Laser(byte initPin);
+
+    // Setters
+    /**
+     * @brief Sets the stimulation duration in seconds (converted to ms).
+     * @param initDuration Duration in seconds.
+     */
+    void setDuration(uint32_t initDuration);
+
+    /**
+     * @brief Sets the frequency of laser pulses.
+     * @param initFrequency Frequency in Hz.
+     */
+    void setFrequency(uint32_t initFrequency);
+
+    /**
+     * @brief Sets the stimulation period start and end times.
+     * @param currentMillis Current time in milliseconds.
+     */
+    void setStimPeriod(uint32_t currentMillis);
+
+    /**
+     * @brief Sets the pulse width.
+     * @param initWidth Width in microseconds, or 0 for half the period.
+     */
+    void setPulseWidth(uint32_t initWidth);
+
+    /**
+     * @brief Sets the logged state of the stimulation.
+     * @param log Boolean indicating logged state.
+     */
+    void setStimLogged(bool log);
+
+    /**
+     * @brief Sets the cycle-up state.
+     * @param cycle Boolean indicating cycle state.
+     */
+    void setCycleUp(bool cycle);
+
+    /**
+     * @brief Sets the stimulation mode.
+     *
+     * Switching to CYCLE clears the stimulation period, so the schedule is anchored again.
+     *
+     * @param mode MODE enum value (CYCLE or ACTIVE_PRESS).
+     */
+    void setStimMode(MODE mode);
+
+    // CYCLE scheduling
+    /**
+     * @brief Starts the CYCLE schedule on an anchor and clears its lag statistics.
+     *
+     * Epoch k runs from anchorMillis + k * duration; even epochs are ON. The period is
+     * set to the epoch containing currentMillis.
+     *
+     * @param anchorMillis Start of epoch 0 (ms).
+     * @param currentMillis Current time in milliseconds.
+     */
+    void startCycle(uint32_t anchorMillis, uint32_t currentMillis);
+
+    /**
+     * @brief Moves the CYCLE schedule on to the epoch containing the current time.
+     *
+     * Call once the current epoch has ended. The next period starts where the last one
+     * ended, not when the end is noticed, so late calls do not shift the schedule;
+     * their delay is recorded instead.
+     *
+     * @param currentMillis Current time in milliseconds, at or after the end of the period.
+     */
+    void advanceCycle(uint32_t currentMillis);
+
+    /**
+     * @brief Sets the stimulation state.
+     * @param state STATE enum value (ACTIVE or INACTIVE).
+     */
+    void setStimState(STATE state);
+
+    /**
+     * @brief Sets the laser action.
+     * @param action ACTION enum value (ON or OFF).
+     */
+    void setStimAction(ACTION action);
+
+    // Getters
+    /**
+     * @brief Gets the stimulation duration.
+     * @return Duration in milliseconds.
+     */
+    uint32_t getDuration();
+
+    /**
+     * @brief Gets the laser pulse frequency.
+     * @return Frequency in Hz.
+     */
+    uint32_t getFrequency();
+
+    /**
+     * @brief Gets the stimulation start time.
+     * @return Start time in milliseconds.
+     */
+    uint32_t getStimStart();
+
+    /**
+     * @brief Gets the stimulation end time.
+     * @return End time in milliseconds.
+     */
+    uint32_t getStimEnd();
+
+    /**
+     * @brief Gets the pulse width as set.
+     * @return Width in microseconds, or 0 for half the period.
+     */
+    uint32_t getPulseWidth();
+
+    /**
+     * @brief Gets the width each pulse is generated with.
+     * @return Width in microseconds; a whole period at 1 Hz (constant stimulation).
+     */
+    uint32_t getEffectivePulseWidth();
+
+    /**
+     * @brief Gets the frequency the pulse train is generated at.
+     * @return Pulses per second (Hz); 1 kHz of gapless pulses for constant stimulation.
+     */
+    uint32_t getTrainFrequency();
+
+    /**
+     * @brief Gets the pulse train played for a stimulation period without a waveform.
+     * @param trainDuration Length of the stimulation period (ms).
+     * @return Pulses at the train frequency and effective pulse width filling the period.
+     */
+    Waveform getPulseTrain(uint32_t trainDuration);
+
+    /**
+     * @brief Checks if the stimulation has been logged.
+     * @return Boolean indicating logged state.
+     */
+    bool getStimLog();
+
+    /**
+     * @brief Checks if the laser is in the active cycle phase.
+     * @return Boolean indicating cycle-up state.
+     */
+    bool getCycleUp();
+
+    /**
+     * @brief Gets the number of CYCLE epochs ended since the cycle started.
+     * @return Epochs, including any passed over entirely.
+     */
+    uint32_t getCycleEpochs();
+
+    /**
+     * @brief Gets the number of CYCLE epochs whose end was noticed late.
+     * @return Late epochs.
+     */
+    uint32_t getLateCycles();
+
+    /**
+     * @brief Gets the longest delay in noticing the end of a CYCLE epoch.
+     * @return Delay in milliseconds.
+     */
+    uint32_t getMaxCycleLag();
+
+    /**
+     * @brief Gets the current stimulation mode.
+     * @return MODE enum value (CYCLE or ACTIVE_PRESS).
+     */
+    MODE getStimMode();
+
+    /**
+     * @brief Gets the current stimulation state.
+     * @return STATE enum value (ACTIVE or INACTIVE).
+     */
+    STATE getStimState();
+
+    /**
+     * @brief Gets the current laser action.
+     * @return ACTION enum value (ON or OFF).
+     */
+    ACTION getStimAction();
+
+    // Pulse train
+    /**
+     * @brief Starts the pulse train for one stimulation period.
+     *
+     * Plays the loaded waveform, or else duration x frequency pulses, on the
+     * timer-driven waveform engine (see PulseTrain.h). A frequency of 1 Hz means
+     * constant stimulation.
+     *
+     * @param currentMillis Current time in milliseconds.
+     * @return Boolean indicating the train started.
+     */
+    bool startPulses(uint32_t currentMillis);
+
+    /**
+     * @brief Lengthens the running pulse train by the time since it was started or last extended.
+     *
+     * Keeps a train going when its stimulation period is restarted before it ends.
+     * Past the longest train the engine can time it carries on in a new train.
+     * A loaded waveform is not lengthened.
+     *
+     * @param currentMillis Current time in milliseconds.
+     */
+    void extendPulses(uint32_t currentMillis);
+
+    /**
+     * @brief Stops the pulse train and drives the pin low.
+     */
+    void stopPulses();
+
+    /**
+     * @brief Checks if the pulse train is running.
+     * @return Boolean indicating the train is running.
+     */
+    bool isPulsing();
+
+    /**
+     * @brief Takes the oldest completed train of the waveform.
+     * @param start Set to the time of its first rising edge on the timebase clock (us).
+     * @param end Set to the time of its last falling edge on the timebase clock (us).
+     * @return Boolean indicating a train was taken.
+     */
+    bool nextTrain(uint64_t& start, uint64_t& end);
+
+    // Waveform
+    /**
+     * @brief Loads a waveform to play in place of the frequency and pulse width.
+     * @param initWaveform Waveform descriptor, checked with pulseTrainValid().
+     */
+    void setWaveform(const Waveform& initWaveform);
+
+    /**
+     * @brief Returns to pulses at the frequency and pulse width for the stimulation duration.
+     */
+    void clearWaveform();
+
+    /**
+     * @brief Checks if a waveform is loaded.
+     * @return Boolean indicating a waveform is loaded.
+     */
+    bool hasWaveform();
+
+    /**
+     * @brief Gets the loaded waveform.
+     * @return Reference to the waveform descriptor.
+     */
+    const Waveform& getWaveform();
+
+    // Laser control
+    /**
+     * @brief Turns the laser on; writes the pin only if the laser is off.
+     *
+     * A running pulse train is stopped first, handing the pin back from the engine.
+     */
+    void on();
+
+    /**
+     * @brief Turns the laser off; writes the pin only if the laser is on.
+     */
+    void off();
+};
+
+#endif // LASER_H
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "Device.h"
+#include "Laser.h"
+#include "FastLaser.h"
+#include "Session.h"
+#include "Event_Utils.h"
+#include "Timebase.h"
+#include <Arduino.h>
+
+extern FastLaser<LASER_PIN> laser;           ///< External reference to the Laser object.
+extern bool programIsRunning;                ///< External flag indicating if the program is running.
+extern uint32_t differenceFromStartTime;     ///< Program start time (ms), the anchor of CYCLE epochs.
+
+/**
+ * @brief Logs the laser's completed trains to the serial monitor.
+ * 
+ * Records one event per train, from its first rising to its last falling edge,
+ * adjusted to the session epoch; individual pulses are not logged.
+ * 
+ * @param laser Reference to the Laser object whose stimulation is being logged.
+ */
+void logStim(Laser& laser) {
+    uint64_t start;
+    uint64_t end;
+    while (laser.nextTrain(start, end)) {
+        logEvent(EVENT_STIM, SOURCE_LASER, DETAIL_NONE, sessionMicros(start), sessionMicros(end));
+    }
+}
+
+/**
+ * @brief Restarts the stimulation period, keeping a running pulse train going.
+ * 
+ * A train still running is lengthened to cover the new period (a loaded waveform
+ * plays on unchanged). Once the train has ended, stim() starts a new one. Only
+ * ACTIVE_PRESS periods follow presses; CYCLE epochs stay on the program start's grid
+ * and are moved on by advanceCycle() alone.
+ * 
+ * @param laser Reference to the Laser object to stimulate.
+ * @param currentMillis Current time in milliseconds.
+ */
+void restartStim(Laser& laser, uint32_t currentMillis) {
+    if (laser.getStimMode() != ACTIVE_PRESS) {
+        return;
+    }
+    laser.setStimPeriod(currentMillis);
+    laser.setStimState(ACTIVE);
+    if (laser.isPulsing()) {
+        laser.extendPulses(currentMillis);
+    } else {
+        laser.setStimLogged(true);
+    }
+}
+
+/**
+ * @brief Checks if the current time is within the laser's stimulation period.
+ * 
+ * @param currentMillis Current time in milliseconds.
+ * @return Boolean indicating if the time falls within the stimulation window [start, end).
+ */
+bool inStimPeriod(uint32_t currentMillis) {
+    return currentMillis >= laser.getStimStart() && currentMillis < laser.getStimEnd();
+}
+
+/**
+ * @brief Manages the laser's stimulation behavior based on time and frequency.
+ * 
+ * Starts the pulse train when a stimulation period begins and cuts it off if it is
+ * still running when the period ends. The train itself runs on a hardware timer (see
+ * PulseTrain.h): the loaded waveform, pulses at the set frequency, or constant
+ * stimulation at 1 Hz. Each train is logged once it has ended.
+ * 
+ * @param laser Reference to the Laser object to stimulate.
+ * @param currentMillis Current time in milliseconds.
+ */
+void stim(Laser& laser, uint32_t currentMillis) {
+    logStim(laser); // Trains ended since the last pass, including any cut short
+    if (inStimPeriod(currentMillis) && laser.getCycleUp()) {
+        laser.setStimState(ACTIVE);
+        if (laser.getStimLog()) { // Period just began; a train that fails to start is not retried
+            laser.setStimLogged(false);
+            if (laser.startPulses(currentMillis)) {
+                laser.setStimAction(ON);
+            }
+        }
+    } else {
+        laser.setStimState(INACTIVE);
+        if (!laser.getStimLog()) { // Period just ended
+            laser.stopPulses();
+            laser.setStimAction(OFF);
+            laser.setStimLogged(true);
+        }
+    }
+}
+
+/**
+ * @brief Oversees the laser's stimulation mode and timing.
+ * 
+ * Manages the laser’s stimulation based on its mode (CYCLE or ACTIVE_PRESS),
+ * updating periods and states if the device is armed and the program is running.
+ * CYCLE epochs are laid on the program start (start + k * duration), the time the
+ * imaging trigger fires, so noticing the end of one late neither lengthens it nor
+ * shifts the ones after.
+ * 
+ * @param laser Reference to the Laser object to manage.
+ */
+void manageStim(Laser& laser) {
+    if (laser.isArmed() && programIsRunning) {
+        uint32_t currentMillis = static_cast<uint32_t>(millis());
+        if (laser.getStimMode() == CYCLE) {
+            if (laser.getStimStart() < differenceFromStartTime) { // No epoch yet in this program
+                laser.startCycle(differenceFromStartTime, currentMillis);
+            } else if (currentMillis >= laser.getStimEnd()) {
+                laser.advanceCycle(currentMillis);
+            }
+        } else if (laser.getStimMode() == ACTIVE_PRESS) {
+            laser.setCycleUp(true);
+        }
+        stim(laser, currentMillis);
+    }
+}
\ No newline at end of file
@@ -8,23 +8,26 @@
  * @file LaserUtils.h
  * @brief Utility functions for managing and logging laser stimulation.
  * 
- * Provides functions to control a laser’s on/off state, log stimulation events,
- * and manage timing-based stimulation behavior.
+ * Provides functions to start and log the laser’s timer-driven pulse trains and
+ * manage timing-based stimulation behavior.
  */
 
 /**
- * @brief Controls the laser’s on/off state based on stimulation settings.
+ * @brief Logs the laser’s completed trains to the serial monitor, one event per train.
  * 
- * @param laser Reference to the Laser object to manage.
+ * @param laser Reference to the Laser object to log.
  */
-void manageLaser(Laser& laser);
+void logStim(Laser& laser);
 
 /**
- * @brief Logs the laser’s stimulation period to the serial monitor.
+ * @brief Restarts the stimulation period, keeping a running pulse train going.
  * 
- * @param laser Reference to the Laser object to log.
+ * Does nothing in CYCLE mode, whose epochs are fixed to the program start.
+ * 
+ * @param laser Reference to the Laser object to stimulate.
+ * @param currentMillis Current time in milliseconds.
  */
-void logStim(Laser& laser);
+void restartStim(Laser& laser, uint32_t currentMillis);
 
 /**
  * @brief Checks if the current time is within the stimulation period.
@@ -0,0 +1,152 @@
+#include "Lever.h"
+
+static const char orientationRH[] PROGMEM = "RH";
+static const char orientationLH[] PROGMEM = "LH";
+static const char pressNoCondition[] PROGMEM = "NO CONDITION";
+static const char pressActive[] PROGMEM = "ACTIVE";
+static const char pressInactive[] PROGMEM = "INACTIVE";
+static const char pressTimeout[] PROGMEM = "TIMEOUT";
+
+static const char* const ORIENTATION_NAMES[] PROGMEM = {orientationRH, orientationLH}; ///< Names in LEVER_ORIENTATION order.
+static const char* const PRESS_TYPE_NAMES[] PROGMEM = {pressNoCondition, pressActive, pressInactive, pressTimeout}; ///< Names in PRESS_TYPE order.
+
+/**
+ * @brief Constructs a Lever object with an initial pin and default settings.
+ * 
+ * Initializes a Lever object as a subclass of Device with default states and timestamps.
+ * 
+ * @param initPin The digital pin (byte) to which the lever is connected.
+ */
+Lever::Lever(byte initPin) 
+    : Device(initPin), debouncer(HIGH, 100), 
+      pressTimestamp(0), releaseTimestamp(0), orientation(LEVER_RH), pressType(PRESS_NO_CONDITION) {}
+
+/**
+ * @brief Feeds a raw input sample into the lever's debouncer.
+ * @param sample Raw input level read from the lever pin.
+ * @param now Sample time in microseconds.
+ * @return EDGE_FALL on a debounced press, EDGE_RISE on a debounced release, otherwise EDGE_NONE.
+ */
+EDGE Lever::debounce(bool sample, uint32_t now) {
+    return debouncer.update(sample, now);
+}
+
+/**
+ * @brief Sets the time the lever input must be steady before a change is accepted.
+ * @param initDebounceTime Debounce time in milliseconds.
+ */
+void Lever::setDebounceTime(uint32_t initDebounceTime) {
+    debouncer.setDebounceTime(initDebounceTime);
+}
+
+/**
+ * @brief Sets the timestamp of a lever press.
+ * @param initTimestamp Time in microseconds when the press occurred.
+ */
+void Lever::setPressTimestamp(uint64_t initTimestamp) {
+    pressTimestamp = initTimestamp;
+}
+
+/**
+ * @brief Sets the timestamp of a lever release.
+ * @param initTimestamp Time in microseconds when the release occurred.
+ */
+void Lever::setReleaseTimestamp(uint64_t initTimestamp) {
+    releaseTimestamp = initTimestamp;
+}
+
+/**
+ * @brief Sets the orientation of the lever.
+ * @param initOrientation LEVER_RH or LEVER_LH.
+ */
+void Lever::setOrientation(LEVER_ORIENTATION initOrientation) {
+    orientation = initOrientation;
+}
+
+/**
+ * @brief Sets the type of press (e.g., PRESS_ACTIVE, PRESS_INACTIVE, PRESS_TIMEOUT).
+ * @param initPressType Press classification.
+ */
+void Lever::setPressType(PRESS_TYPE initPressType) {
+    pressType = initPressType;
+}
+
+/**
+ * @brief Retrieves the debounce time.
+ * @return Debounce time in milliseconds.
+ */
+uint32_t Lever::getDebounceTime() const {
+    return debouncer.getDebounceTime();
+}
+
+/**
+ * @brief Retrieves the time of the last debounced edge.
+ * @return Time of the first sample of the edge (low 32 bits of the timebase, us).
+ */
+uint32_t Lever::getEdgeTime() const {
+    return debouncer.getEdgeTime();
+}
+
+/**
+ * @brief Retrieves the previous lever state.
+ * @return Boolean indicating the previous state.
+ */
+bool Lever::getPreviousLeverState() const {
+    return debouncer.getPreviousState();
+}
+
+/**
+ * @brief Retrieves the stable lever state.
+ * @return Boolean indicating the stable state.
+ */
+bool Lever::getStableLeverState() const {
+    return debouncer.getStableState();
+}
+
+/**
+ * @brief Retrieves the press timestamp.
+ * @return Time in microseconds of the press.
+ */
+uint64_t Lever::getPressTimestamp() const {
+    return pressTimestamp;
+}
+
+/**
+ * @brief Retrieves the release timestamp.
+ * @return Time in microseconds of the release.
+ */
+uint64_t Lever::getReleaseTimestamp() const {
+    return releaseTimestamp;
+}
+
+/**
+ * @brief Retrieves the lever's orientation.
+ * @return LEVER_RH or LEVER_LH.
+ */
+LEVER_ORIENTATION Lever::getOrientation() const {
+    return static_cast<LEVER_ORIENTATION>(orientation);
+}
+
+/**
+ * @brief Retrieves the press type.
+ * @return Press classification.
+ */
+PRESS_TYPE Lever::getPressType() const {
+    return static_cast<PRESS_TYPE>(pressType);
+}
+
+/**
+ * @brief Retrieves the name of the lever's orientation.
+ * @return "RH" or "LH", stored in flash.
+ */
+const __FlashStringHelper* Lever::getOrientationName() const {
+    return reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&ORIENTATION_NAMES[orientation]));
+}
+
+/**
+ * @brief Retrieves the name of the press type.
+ * @return Press type name (e.g., "ACTIVE"), stored in flash.
+ */
+const __FlashStringHelper* Lever::getPressTypeName() const {
+    return reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&PRESS_TYPE_NAMES[pressType]));
+}
\ No newline at end of file
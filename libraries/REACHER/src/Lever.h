@@ -0,0 +1,151 @@
+#ifndef LEVER_H
+#define LEVER_H
+
+#include "Device.h"
+#include "Debouncer.h"
+#include <Arduino.h>
+
+/**
+ * @file Lever.h
+ * @brief Defines the Lever class for monitoring lever interactions.
+ */
+
+/**
+ * @enum LEVER_ORIENTATION
+ * @brief Side of the chamber a lever is mounted on.
+ */
+enum LEVER_ORIENTATION : uint8_t { LEVER_RH, ///< Right-hand lever ("RH").
+                                   LEVER_LH  ///< Left-hand lever ("LH").
+};
+
+/**
+ * @enum PRESS_TYPE
+ * @brief Classification of a lever press by the schedule.
+ */
+enum PRESS_TYPE : uint8_t { PRESS_NO_CONDITION, ///< "NO CONDITION" press (default).
+                            PRESS_ACTIVE,       ///< "ACTIVE" press.
+                            PRESS_INACTIVE,     ///< "INACTIVE" press.
+                            PRESS_TIMEOUT       ///< "TIMEOUT" press.
+};
+
+/**
+ * @class Lever
+ * @brief A subclass of Device representing a lever input device.
+ * 
+ * Manages lever state, timestamps, orientation, and press type for behavioral experiments.
+ * Orientation and press type are packed into one byte; their names live in flash.
+ */
+class Lever : public Device {
+public:
+    Debouncer debouncer;         ///< Debounces this lever's input (idle HIGH).
+    uint64_t pressTimestamp;     ///< Timestamp of the lever press (us).
+    uint64_t releaseTimestamp;   ///< Timestamp of the lever release (us).
+    uint8_t orientation : 1;     ///< Lever orientation (LEVER_ORIENTATION).
+    uint8_t pressType : 2;       ///< Classification of the current press (PRESS_TYPE).
+
+    /**
+     * @brief Constructor for the Lever class.
+     * @param initPin The digital pin to which the lever is connected.
+     */
+    Lever(byte initPin);
+
+    /**
+     * @brief Feeds a raw input sample into the lever's debouncer.
+     * @param sample Raw input level.
+     * @param now Sample time in microseconds.
+     * @return EDGE_FALL on a debounced press, EDGE_RISE on a debounced release, otherwise EDGE_NONE.
+     */
+    EDGE debounce(bool sample, uint32_t now);
+
+    /**
+     * @brief Sets the debounce time.
+     * @param initDebounceTime Debounce time in milliseconds.
+     */
+    void setDebounceTime(uint32_t initDebounceTime);
+
+    /**
+     * @brief Sets the press timestamp.
+     * @param initTimestamp Time in microseconds.
+     */
+    void setPressTimestamp(uint64_t initTimestamp);
+
+    /**
+     * @brief Sets the release timestamp.
+     * @param initTimestamp Time in microseconds.
+     */
+    void setReleaseTimestamp(uint64_t initTimestamp);
+
+    /**
+     * @brief Sets the lever orientation.
+     * @param initOrientation LEVER_RH or LEVER_LH.
+     */
+    void setOrientation(LEVER_ORIENTATION initOrientation);
+
+    /**
+     * @brief Sets the press type.
+     * @param initPressType Press classification (e.g., PRESS_ACTIVE).
+     */
+    void setPressType(PRESS_TYPE initPressType);
+
+    /**
+     * @brief Gets the debounce time.
+     * @return Debounce time in milliseconds.
+     */
+    uint32_t getDebounceTime() const;
+
+    /**
+     * @brief Gets the time of the last debounced edge.
+     * @return Time of the first sample of the edge (low 32 bits of the timebase, us).
+     */
+    uint32_t getEdgeTime() const;
+
+    /**
+     * @brief Gets the previous lever state.
+     * @return Boolean previous state.
+     */
+    bool getPreviousLeverState() const;
+
+    /**
+     * @brief Gets the stable lever state.
+     * @return Boolean stable state.
+     */
+    bool getStableLeverState() const;
+
+    /**
+     * @brief Gets the press timestamp.
+     * @return Time in microseconds.
+     */
+    uint64_t getPressTimestamp() const;
+
+    /**
+     * @brief Gets the release timestamp.
+     * @return Time in microseconds.
+     */
+    uint64_t getReleaseTimestamp() const;
+
+    /**
+     * @brief Gets the lever orientation.
+     * @return LEVER_RH or LEVER_LH.
+     */
+    LEVER_ORIENTATION getOrientation() const;
+
+    /**
+     * @brief Gets the press type.
+     * @return Press classification.
+     */
+    PRESS_TYPE getPressType() const;
+
+    /**
+     * @brief Gets the name of the lever orientation.
+     * @return "RH" or "LH", stored in flash.
+     */
+    const __FlashStringHelper* getOrientationName() const;
+
+    /**
+     * @brief Gets the name of the press type.
+     * @return Press type name (e.g., "ACTIVE"), stored in flash.
+     */
+    const __FlashStringHelper* getPressTypeName() const;
+};
+
+#endif // LEVER_H
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "Lever.h"
+#include "Cue.h"
+#include "Cue_Utils.h"
+#include "Pump.h"
+#include "Pump_Utils.h"
+#include "Laser.h"
+#include "Program_Utils.h"
+#include "Event_Utils.h"
+#include "Timebase.h"
+#include "InputSampler.h"
+#include "Schedule.h"
+#include <Arduino.h>
+
+extern InputSampler inputSampler;           ///< Snapshot of the input pins for this pass.
+
+/**
+ * @brief Maps a lever's press type to its event detail code.
+ * 
+ * @param lever Pointer to the Lever object.
+ * @return EVENT_DETAIL matching the lever's press type.
+ */
+static EVENT_DETAIL pressDetail(const Lever* lever) {
+    switch (lever->getPressType()) {
+        case PRESS_ACTIVE: return DETAIL_ACTIVE;
+        case PRESS_INACTIVE: return DETAIL_INACTIVE;
+        case PRESS_TIMEOUT: return DETAIL_TIMEOUT;
+        default: return DETAIL_NO_CONDITION;
+    }
+}
+
+/**
+ * @brief Logs lever press and release data to the serial monitor.
+ * 
+ * Records the press and release timestamps of a lever, adjusted to the session epoch.
+ * 
+ * @param lever Reference to a pointer to the Lever object being monitored.
+ * @param pump Pointer to the Pump object (optional, can be nullptr).
+ */
+void pressingDataEntry(Lever*& lever, Pump* pump) {
+    logEvent(EVENT_LEVER_PRESS,
+             lever->getOrientation() == LEVER_RH ? SOURCE_RH_LEVER : SOURCE_LH_LEVER,
+             pressDetail(lever),
+             sessionMicros(lever->getPressTimestamp()),
+             sessionMicros(lever->getReleaseTimestamp())); // Send data to serial connection
+}
+
+/**
+ * @brief Monitors lever pressing with debouncing and triggers associated actions.
+ * 
+ * Checks the lever state from the current input snapshot, applies the lever's own debouncer, and handles
+ * press/release events. Each lever keeps its own debounce window, so activity on one
+ * lever never delays or masks presses on the other. With INPUT_SAMPLER_VERTICAL_DEBOUNCE
+ * the edges come from the sampler's port debouncers instead. Presses and releases are
+ * timestamped with the first sample of the edge, not the end of the debounce time.
+ * The cue is run from here; the caller runs the pump with managePump(), on its own type.
+ * 
+ * @param programRunning Boolean indicating if the program is running.
+ * @param lever Reference to a pointer to the Lever object being monitored.
+ * @param cue Pointer to the Cue object (optional, can be nullptr).
+ * @param pump Pointer to the Pump object (optional, can be nullptr).
+ * @param laser Pointer to the Laser object (optional, can be nullptr).
+ */
+void monitorPressing(bool programRunning, Lever*& lever, Cue* cue, Pump* pump, Laser* laser) {
+    manageCue(cue); // Manage cue delivery
+    if (lever->isArmed()) {
+        uint64_t now = inputSampler.getTimestamp();
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+        EDGE edge = inputSampler.edge(lever->getPin());
+        uint32_t edgeTime = inputSampler.getEdgeTime();
+#else
+        EDGE edge = lever->debounce(inputSampler.read(lever->getPin()), static_cast<uint32_t>(now));
+        uint32_t edgeTime = lever->getEdgeTime();
+#endif
+        uint64_t edgeAt = now - static_cast<uint32_t>(static_cast<uint32_t>(now) - edgeTime);
+        if (edge == EDGE_FALL) { // Lever press detected
+            lever->setPressTimestamp(edgeAt);
+            definePressActivity(programRunning, lever, cue, pump, laser);
+        } else if (edge == EDGE_RISE) { // Lever release detected
+            lever->setReleaseTimestamp(edgeAt);
+            pressingDataEntry(lever, pump);
+        }
+    }
+}
\ No newline at end of file
@@ -22,18 +22,10 @@
  */
 void pressingDataEntry(Lever*& lever, Pump* pump);
 
-/**
- * @brief Defines the type of lever press and associated actions.
- * @param programRunning Boolean indicating if the program is running.
- * @param lever Reference to a pointer to the Lever object.
- * @param cue Pointer to the Cue object (optional).
- * @param pump Pointer to the Pump object (optional).
- * @param laser Pointer to the Laser object (optional).
- */
-void definePressActivity(bool programRunning, Lever*& lever, Cue* cue, Pump* pump, Laser* laser);
-
 /**
  * @brief Monitors lever pressing with debouncing.
+ * 
+ * Each debounced press is passed to the schedule's definePressActivity() (see Schedule.h).
  * @param programRunning Boolean indicating if the program is running.
  * @param lever Reference to a pointer to the Lever object.
  * @param cue Pointer to the Cue object (optional).
@@ -0,0 +1,93 @@
+#include "LickCircuit.h"
+
+/**
+ * @brief Constructs a LickCircuit object with an initial pin and default settings.
+ * 
+ * Initializes a LickCircuit object as a subclass of Device with default states and timestamps.
+ * 
+ * @param initPin The digital pin (byte) to which the lick circuit is connected.
+ */
+LickCircuit::LickCircuit(byte initPin) 
+    : Device(initPin), debouncer(LOW, 25), lickTimestamp(0), releaseTimestamp(0) {}
+
+/**
+ * @brief Feeds a raw input sample into the circuit's debouncer.
+ * @param sample Raw input level read from the lick circuit pin.
+ * @param now Sample time in microseconds.
+ * @return EDGE_RISE on a debounced touch, EDGE_FALL on a debounced release, otherwise EDGE_NONE.
+ */
+EDGE LickCircuit::debounce(bool sample, uint32_t now) {
+    return debouncer.update(sample, now);
+}
+
+/**
+ * @brief Sets the time the lick input must be steady before a change is accepted.
+ * @param initDebounceTime Debounce time in milliseconds.
+ */
+void LickCircuit::setDebounceTime(uint32_t initDebounceTime) {
+    debouncer.setDebounceTime(initDebounceTime);
+}
+
+/**
+ * @brief Sets the timestamp of a lick touch.
+ * @param initTimestamp Time in microseconds when the lick occurred.
+ */
+void LickCircuit::setLickTouchTimestamp(uint64_t initTimestamp) {
+    lickTimestamp = initTimestamp;
+}
+
+/**
+ * @brief Sets the timestamp of a lick release.
+ * @param initTimestamp Time in microseconds when the release occurred.
+ */
+void LickCircuit::setLickReleaseTimestamp(uint64_t initTimestamp) {
+    releaseTimestamp = initTimestamp;
+}
+
+/**
+ * @brief Retrieves the debounce time.
+ * @return Debounce time in milliseconds.
+ */
+uint32_t LickCircuit::getDebounceTime() const {
+    return debouncer.getDebounceTime();
+}
+
+/**
+ * @brief Retrieves the time of the last debounced edge.
+ * @return Time of the first sample of the edge (low 32 bits of the timebase, us).
+ */
+uint32_t LickCircuit::getEdgeTime() const {
+    return debouncer.getEdgeTime();
+}
+
+/**
+ * @brief Retrieves the previous lick state.
+ * @return Boolean indicating the previous state.
+ */
+bool LickCircuit::getPreviousLickState() const {
+    return debouncer.getPreviousState();
+}
+
+/**
+ * @brief Retrieves the stable lick state.
+ * @return Boolean indicating the stable state.
+ */
+bool LickCircuit::getStableLickState() const {
+    return debouncer.getStableState();
+}
+
+/**
+ * @brief Retrieves the lick touch timestamp.
+ * @return Time in microseconds of the lick.
+ */
+uint64_t LickCircuit::getLickTouchTimestamp() const {
+    return lickTimestamp;
+}
+
+/**
+ * @brief Retrieves the lick release timestamp.
+ * @return Time in microseconds of the release.
+ */
+uint64_t LickCircuit::getLickReleaseTimestamp() const {
+    return releaseTimestamp;
+}
\ No newline at end of file
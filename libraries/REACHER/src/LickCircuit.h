@@ -0,0 +1,95 @@
+#ifndef LICKCIRCUIT_H
+#define LICKCIRCUIT_H
+
+#include "Arduino.h"
+#include "Device.h"
+#include "Debouncer.h"
+
+/**
+ * @file LickCircuit.h
+ * @brief Defines the LickCircuit class for monitoring lick interactions.
+ */
+
+/**
+ * @class LickCircuit
+ * @brief A subclass of Device representing a lick detection circuit.
+ * 
+ * Manages lick state and timestamps for behavioral experiments.
+ */
+class LickCircuit : public Device {
+private:
+    Debouncer debouncer;       ///< Debounces this circuit's input (idle LOW).
+    uint64_t lickTimestamp;    ///< Timestamp of the lick touch (us).
+    uint64_t releaseTimestamp; ///< Timestamp of the lick release (us).
+
+public:
+    /**
+     * @brief Constructor for the LickCircuit class.
+     * @param initPin The digital pin to which the lick circuit is connected.
+     */
+    LickCircuit(byte initPin);
+
+    /**
+     * @brief Feeds a raw input sample into the circuit's debouncer.
+     * @param sample Raw input level.
+     * @param now Sample time in microseconds.
+     * @return EDGE_RISE on a debounced touch, EDGE_FALL on a debounced release, otherwise EDGE_NONE.
+     */
+    EDGE debounce(bool sample, uint32_t now);
+
+    /**
+     * @brief Sets the debounce time.
+     * @param initDebounceTime Debounce time in milliseconds.
+     */
+    void setDebounceTime(uint32_t initDebounceTime);
+
+    /**
+     * @brief Sets the lick touch timestamp.
+     * @param initTimestamp Time in microseconds.
+     */
+    void setLickTouchTimestamp(uint64_t initTimestamp);
+
+    /**
+     * @brief Sets the lick release timestamp.
+     * @param initTimestamp Time in microseconds.
+     */
+    void setLickReleaseTimestamp(uint64_t initTimestamp);
+
+    /**
+     * @brief Gets the debounce time.
+     * @return Debounce time in milliseconds.
+     */
+    uint32_t getDebounceTime() const;
+
+    /**
+     * @brief Gets the time of the last debounced edge.
+     * @return Time of the first sample of the edge (low 32 bits of the timebase, us).
+     */
+    uint32_t getEdgeTime() const;
+
+    /**
+     * @brief Gets the previous lick state.
+     * @return Boolean previous state.
+     */
+    bool getPreviousLickState() const;
+
+    /**
+     * @brief Gets the stable lick state.
+     * @return Boolean stable state.
+     */
+    bool getStableLickState() const;
+
+    /**
+     * @brief Gets the lick touch timestamp.
+     * @return Time in microseconds.
+     */
+    uint64_t getLickTouchTimestamp() const;
+
+    /**
+     * @brief Gets the lick release timestamp.
+     * @return Time in microseconds.
+     */
+    uint64_t getLickReleaseTimestamp() const;
+};
+
+#endif // LICKCIRCUIT_H
\ No newline at end of file
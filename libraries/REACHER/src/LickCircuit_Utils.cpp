@@ -0,0 +1,39 @@
+#include "LickCircuit.h"
+#include "Event_Utils.h"
+#include "Timebase.h"
+#include "InputSampler.h"
+#include <Arduino.h>
+
+extern InputSampler inputSampler; ///< Snapshot of the input pins for this pass.
+
+/**
+ * @brief Monitors licking activity on a lick circuit with debouncing.
+ * 
+ * Detects lick touch and release events through the circuit's own debouncer, and logs timestamps
+ * adjusted to the session epoch when the lick circuit is armed. With INPUT_SAMPLER_VERTICAL_DEBOUNCE
+ * the edges come from the sampler's port debouncers instead. Touches and releases are
+ * timestamped with the first sample of the edge, not the end of the debounce time.
+ * 
+ * @param lickSpout Reference to the LickCircuit object being monitored.
+ */
+void monitorLicking(LickCircuit& lickSpout) {
+    if (lickSpout.isArmed()) {
+        uint64_t now = inputSampler.getTimestamp();
+#if defined(INPUT_SAMPLER_VERTICAL_DEBOUNCE)
+        EDGE edge = inputSampler.edge(lickSpout.getPin());
+        uint32_t edgeTime = inputSampler.getEdgeTime();
+#else
+        EDGE edge = lickSpout.debounce(inputSampler.read(lickSpout.getPin()), static_cast<uint32_t>(now));
+        uint32_t edgeTime = lickSpout.getEdgeTime();
+#endif
+        uint64_t edgeAt = now - static_cast<uint32_t>(static_cast<uint32_t>(now) - edgeTime);
+        if (edge == EDGE_RISE) { // Lick touch detected
+            lickSpout.setLickTouchTimestamp(edgeAt);
+        } else if (edge == EDGE_FALL) { // Lick release detected
+            lickSpout.setLickReleaseTimestamp(edgeAt);
+            logEvent(EVENT_LICK, SOURCE_LICK_CIRCUIT, DETAIL_NONE,
+                     sessionMicros(lickSpout.getLickTouchTimestamp()),
+                     sessionMicros(lickSpout.getLickReleaseTimestamp())); // Log lick event
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "LoopMonitor.h"
+#include <Arduino.h>
+
+static uint32_t lastPass = 0;         ///< micros() at the start of the previous pass.
+static bool started = false;          ///< Whether lastPass holds a pass.
+static uint32_t deadlineMicros = 1000; ///< Loop period counted as a missed deadline (us).
+static uint32_t passes = 0;           ///< Passes in the current window.
+static uint32_t longestPeriod = 0;    ///< Longest period in the current window (us).
+static uint32_t missedDeadlines = 0;  ///< Passes over the deadline in the current window.
+static uint32_t bins[LOOP_PERIOD_BINS]; ///< Passes per log2 period bin in the current window.
+
+/**
+ * @brief Records the time since the previous call as one loop period.
+ *
+ * Bin 0 holds periods under 32 us, bin k periods of [2^(k+4), 2^(k+5)) us, and the last
+ * bin everything from 8192 us up.
+ */
+void loopMonitorTick() {
+    uint32_t now = micros();
+    if (!started) {
+        started = true;
+        lastPass = now;
+        return;
+    }
+    uint32_t period = now - lastPass;
+    lastPass = now;
+    passes++;
+    if (period > longestPeriod) {
+        longestPeriod = period;
+    }
+    if (period > deadlineMicros) {
+        missedDeadlines++;
+    }
+    uint8_t bin = 0;
+    for (uint32_t bound = 32; bin < LOOP_PERIOD_BINS - 1 && period >= bound; bound <<= 1) {
+        bin++;
+    }
+    bins[bin]++;
+}
+
+/**
+ * @brief Sets the period above which a loop pass counts as a missed deadline.
+ * @param deadline Deadline (us).
+ */
+void loopMonitorSetDeadline(uint32_t deadline) {
+    deadlineMicros = deadline;
+}
+
+/**
+ * @brief Gets the missed-deadline threshold.
+ * @return Deadline (us).
+ */
+uint32_t loopMonitorGetDeadline() {
+    return deadlineMicros;
+}
+
+/**
+ * @brief Writes the periods recorded since the last report and starts a new window.
+ */
+void loopMonitorReport() {
+    Serial.print(200);
+    Serial.print(',');
+    Serial.print(passes);
+    Serial.print(',');
+    Serial.print(longestPeriod);
+    Serial.print(',');
+    Serial.print(deadlineMicros);
+    Serial.print(',');
+    Serial.print(missedDeadlines);
+    for (uint8_t bin = 0; bin < LOOP_PERIOD_BINS; bin++) {
+        Serial.print(',');
+        Serial.print(bins[bin]);
+        bins[bin] = 0;
+    }
+    Serial.println();
+    passes = 0;
+    longestPeriod = 0;
+    missedDeadlines = 0;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef LOOP_MONITOR_H
+#define LOOP_MONITOR_H
+
+#include <Arduino.h>
+
+/**
+ * @file LoopMonitor.h
+ * @brief Records how long each pass of loop() takes and how often it overruns a deadline.
+ *
+ * loopMonitorTick() is called at the start of every loop() pass and bins the time since
+ * the previous pass into a fixed log2 histogram. pingDevice() reports and clears the
+ * histogram with every ping, so each report covers one ping interval.
+ */
+
+const uint8_t LOOP_PERIOD_BINS = 10; ///< Histogram bins: <32 us, one per power of two, then >=8192 us.
+
+/**
+ * @brief Records the time since the previous call as one loop period.
+ *
+ * The first call only starts the clock.
+ */
+void loopMonitorTick();
+
+/**
+ * @brief Sets the period above which a loop pass counts as a missed deadline.
+ * @param deadline Deadline (us).
+ */
+void loopMonitorSetDeadline(uint32_t deadline);
+
+/**
+ * @brief Gets the missed-deadline threshold.
+ * @return Deadline (us).
+ */
+uint32_t loopMonitorGetDeadline();
+
+/**
+ * @brief Writes the periods recorded since the last report and starts a new window.
+ *
+ * Writes "200,<passes>,<max us>,<deadline us>,<missed>,<bin 0>,...,<bin 9>". The leading
+ * 200 is the original ping, so a host that only looks for it still sees the ping.
+ */
+void loopMonitorReport();
+
+#endif // LOOP_MONITOR_H
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "Profiler.h"
+#include <Arduino.h>
+#include "Timebase.h"
+
+#if defined(REACHER_PROFILE)
+
+#if defined(__AVR_ATmega328P__)
+#define PROFILER_TIMER1 ///< Count cycles on Timer1 at clk/1.
+#endif
+
+#if defined(F_CPU)
+const uint32_t CYCLES_PER_MICRO = F_CPU / 1000000UL; ///< CPU cycles per microsecond.
+#else
+const uint32_t CYCLES_PER_MICRO = 16;                ///< Host builds report cycles of a 16 MHz UNO.
+#endif
+
+/**
+ * @struct ProbeStats
+ * @brief Execution times recorded by one probe.
+ */
+struct ProbeStats {
+    uint32_t runs;                   ///< Number of runs recorded.
+    uint64_t total;                  ///< Sum of execution times (cycles).
+    uint32_t shortest;               ///< Shortest execution time (cycles).
+    uint32_t longest;                ///< Longest execution time (cycles).
+    uint32_t bins[PROFILER_BINS];    ///< Runs per log2 execution-time bin.
+};
+
+static ProbeStats probes[PROBE_COUNT]; ///< Statistics per probe.
+
+static const char probePressActive[] PROGMEM = "PRESS_ACTIVE";
+static const char probePressInactive[] PROGMEM = "PRESS_INACTIVE";
+static const char probeLick[] PROGMEM = "LICK";
+static const char probeStim[] PROGMEM = "STIM";
+static const char probeFrames[] PROGMEM = "FRAMES";
+static const char probePing[] PROGMEM = "PING";
+static const char probeSerial[] PROGMEM = "SERIAL";
+
+/**
+ * @brief Probe names as reported by profilerReport(), in PROFILE_PROBE order.
+ */
+static const char* const PROBE_NAMES[PROBE_COUNT] = {
+    probePressActive, probePressInactive, probeLick, probeStim, probeFrames, probePing, probeSerial
+};
+
+#if defined(PROFILER_TIMER1)
+
+static volatile uint16_t timer1Overflows = 0; ///< Upper 16 bits of the cycle count.
+
+/**
+ * @brief Counts Timer1 overflows to extend it to 32 bits.
+ */
+ISR(TIMER1_OVF_vect) {
+    timer1Overflows++;
+}
+
+/**
+ * @brief Starts Timer1 free-running at clk/1 with its overflow interrupt.
+ */
+void profilerBegin() {
+    noInterrupts();
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TCNT1 = 0;
+    TIFR1 = _BV(TOV1);
+    TIMSK1 = _BV(TOIE1);
+    interrupts();
+}
+
+/**
+ * @brief Gets the cycle counter from Timer1 and its overflow count.
+ *
+ * If an overflow is pending and the count was read after the wrap, the pending
+ * overflow is counted.
+ *
+ * @return CPU cycles since profilerBegin().
+ */
+uint32_t profilerCycles() {
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    uint16_t count = TCNT1;
+    uint16_t overflows = timer1Overflows;
+    if ((TIFR1 & _BV(TOV1)) && count < 0x8000) {
+        overflows++;
+    }
+    SREG = oldSREG;
+    return (static_cast<uint32_t>(overflows) << 16) | count;
+}
+
+#else
+
+/**
+ * @brief Starts the cycle counter; micros() needs no setup.
+ */
+void profilerBegin() {
+}
+
+/**
+ * @brief Gets the cycle counter from micros().
+ *
+ * @return micros() in CPU cycles.
+ */
+uint32_t profilerCycles() {
+    return micros() * CYCLES_PER_MICRO;
+}
+
+#endif
+
+/**
+ * @brief Adds one execution time to a probe.
+ *
+ * Bin 0 holds runs under 64 cycles, bin k runs of [2^(k+5), 2^(k+6)) cycles, and the
+ * last bin everything from 2^16 cycles (~4 ms at 16 MHz) up.
+ *
+ * @param probe Probe.
+ * @param cycles Execution time (cycles).
+ */
+void profilerRecord(PROFILE_PROBE probe, uint32_t cycles) {
+    ProbeStats& stats = probes[probe];
+    if (stats.runs == 0 || cycles < stats.shortest) {
+        stats.shortest = cycles;
+    }
+    if (cycles > stats.longest) {
+        stats.longest = cycles;
+    }
+    stats.total += cycles;
+    stats.runs++;
+    uint8_t bin = 0;
+    for (uint32_t bound = 64; bin < PROFILER_BINS - 1 && cycles >= bound; bound <<= 1) {
+        bin++;
+    }
+    stats.bins[bin]++;
+}
+
+/**
+ * @brief Clears every probe.
+ */
+void profilerReset() {
+    memset(probes, 0, sizeof(probes));
+}
+
+/**
+ * @brief Writes a 64-bit value in decimal, which Print cannot do on AVR.
+ * @param value Value to write.
+ */
+static void printUint64(uint64_t value) {
+    char digits[21];
+    char* p = digits + sizeof(digits);
+    *--p = '\0';
+    do {
+        *--p = '0' + static_cast<char>(value % 10);
+        value /= 10;
+    } while (value);
+    Serial.print(p);
+}
+
+/**
+ * @brief Writes the probes to the serial port.
+ */
+void profilerReport() {
+    for (uint8_t i = 0; i < PROBE_COUNT; i++) {
+        const ProbeStats& stats = probes[i];
+        Serial.print(F("STATS,"));
+        Serial.print(reinterpret_cast<const __FlashStringHelper*>(PROBE_NAMES[i]));
+        Serial.print(',');
+        Serial.print(stats.runs);
+        Serial.print(',');
+        printUint64(stats.total);
+        Serial.print(',');
+        Serial.print(stats.shortest);
+        Serial.print(',');
+        Serial.print(stats.longest);
+        for (uint8_t bin = 0; bin < PROFILER_BINS; bin++) {
+            Serial.print(',');
+            Serial.print(stats.bins[bin]);
+        }
+        Serial.println();
+    }
+}
+
+#else
+
+/**
+ * @brief Does nothing without REACHER_PROFILE.
+ */
+void profilerBegin() {
+}
+
+/**
+ * @brief Gets the cycle counter; always 0 without REACHER_PROFILE.
+ *
+ * @return 0.
+ */
+uint32_t profilerCycles() {
+    return 0;
+}
+
+/**
+ * @brief Does nothing without REACHER_PROFILE.
+ *
+ * @param probe Unused.
+ * @param cycles Unused.
+ */
+void profilerRecord(PROFILE_PROBE probe, uint32_t cycles) {
+    (void)probe;
+    (void)cycles;
+}
+
+/**
+ * @brief Does nothing without REACHER_PROFILE.
+ */
+void profilerReset() {
+}
+
+/**
+ * @brief Reports that the probes are not built in.
+ */
+void profilerReport() {
+    Serial.println(F("STATS,DISABLED"));
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+
+/**
+ * @file Profiler.h
+ * @brief Cycle-counting probes around the stages of PROGRAM(), for instrumentation builds.
+ *
+ * Uncomment REACHER_PROFILE below (or pass -DREACHER_PROFILE) to build with the probes.
+ * Each probe accumulates the number of runs, the total, shortest and longest execution
+ * time in CPU cycles, and a log2 histogram of execution times; the "STATS" command
+ * writes them out. Without REACHER_PROFILE the probes compile to nothing and "STATS"
+ * only reports that profiling is off.
+ *
+ * On an ATmega328P the probes count cycles on Timer1 at clk/1, so Timer1 is reserved
+ * for the profiler and TIMEBASE_INPUT_CAPTURE (which also needs it) is rejected at
+ * compile time. On other targets they fall back to micros() scaled to cycles.
+ */
+
+// #define REACHER_PROFILE ///< Uncomment to build with the PROGRAM() stage probes.
+
+const uint8_t PROFILER_BINS = 12; ///< Histogram bins: <64 cycles, then one per power of two, then >=64k cycles.
+
+/**
+ * @enum PROFILE_PROBE
+ * @brief Stages of PROGRAM() with a probe.
+ */
+enum PROFILE_PROBE {
+    PROBE_PRESS_ACTIVE,              ///< monitorPressing() on the active lever.
+    PROBE_PRESS_INACTIVE,            ///< monitorPressing() on the inactive lever.
+    PROBE_LICK,                      ///< monitorLicking().
+    PROBE_STIM,                      ///< manageStim().
+    PROBE_FRAMES,                    ///< handleFrameSignal().
+    PROBE_PING,                      ///< pingDevice().
+    PROBE_SERIAL,                    ///< monitorSerialCommands().
+    PROBE_COUNT
+};
+
+/**
+ * @brief Starts the cycle counter used by the probes.
+ */
+void profilerBegin();
+
+/**
+ * @brief Gets the cycle counter.
+ * @return CPU cycles since profilerBegin(); wraps at 32 bits.
+ */
+uint32_t profilerCycles();
+
+/**
+ * @brief Adds one execution time to a probe.
+ * @param probe Probe.
+ * @param cycles Execution time (cycles).
+ */
+void profilerRecord(PROFILE_PROBE probe, uint32_t cycles);
+
+/**
+ * @brief Clears every probe.
+ */
+void profilerReset();
+
+/**
+ * @brief Writes the probes to the serial port.
+ *
+ * One "STATS,<probe>,<runs>,<total cycles>,<min>,<max>,<bin 0>,...,<bin 11>" line per
+ * probe, or "STATS,DISABLED" in a build without REACHER_PROFILE.
+ */
+void profilerReport();
+
+/**
+ * @class ProfilerProbe
+ * @brief Times the scope it is declared in and records it to a probe.
+ */
+class ProfilerProbe {
+#if defined(REACHER_PROFILE)
+private:
+    PROFILE_PROBE probe;             ///< Probe the scope is recorded to.
+    uint32_t start;                  ///< Cycle counter at the start of the scope.
+
+public:
+    /**
+     * @brief Starts timing a scope.
+     * @param probe Probe to record to.
+     */
+    explicit ProfilerProbe(PROFILE_PROBE probe) : probe(probe), start(profilerCycles()) {}
+
+    /**
+     * @brief Records the time since construction.
+     */
+    ~ProfilerProbe() {
+        profilerRecord(probe, profilerCycles() - start);
+    }
+#else
+public:
+    /**
+     * @brief Does nothing without REACHER_PROFILE.
+     * @param probe Unused.
+     */
+    explicit ProfilerProbe(PROFILE_PROBE probe) {
+        (void)probe;
+    }
+#endif
+};
+
+#endif // PROFILER_H
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "Program_Utils.h"
+#include "Device.h"
+#include "Lever.h"
+#include "LickCircuit.h"
+#include "Laser.h"
+#include "Pump.h"
+#include "Cue.h"
+#include "FastPump.h"
+#include "FastLaser.h"
+#include "Session.h"
+#include "Event_Utils.h"
+#include "Laser_Utils.h"
+#include "Timebase.h"
+
+extern uint32_t traceIntervalLength;     ///< Length of the trace interval (ms).
+extern uint32_t timeoutIntervalStart;    ///< Start time of the timeout interval (ms).
+extern uint32_t timeoutIntervalEnd;      ///< End time of the timeout interval (ms).
+extern uint32_t timeoutIntervalLength;   ///< Length of the timeout interval (ms).
+extern uint32_t differenceFromStartTime; ///< Offset from program start time (ms).
+extern Lever leverRH, leverLH;           ///< Right and left lever objects.
+extern Cue cs;                           ///< Cue object.
+extern FastPump<PUMP_PIN> pump;          ///< Pump object.
+extern LickCircuit lickCircuit;          ///< Lick circuit object.
+extern FastLaser<LASER_PIN> laser;       ///< Laser object.
+
+/**
+ * @brief Starts the program and triggers imaging.
+ * 
+ * Signals the start of the program and sets the time offset for timestamps. The
+ * trigger pulse is ended by the scheduler, so the session epoch coincides with
+ * its rising edge. Queued events are sent first, since the queue holds their
+ * timestamps relative to the old epoch.
+ * 
+ * @param imagingTrigger Pulse generator on the imaging trigger pin.
+ */
+void startProgram(PulseGenerator& imagingTrigger) {
+    flushEvents();                                     // Send events queued against the old epoch
+    Serial.println();
+    Serial.println(F("========== PROGRAM START =========="));
+    Serial.println();
+    imagingTrigger.pulse(IMAGING_TRIGGER_PULSE_WIDTH); // Trigger imaging start
+    differenceFromStartTime = millis();                // Set program start offset
+    timebaseStartEpoch();                              // Log timestamps relative to program start
+}
+
+/**
+ * @brief Ends the program and disarms all devices.
+ * 
+ * Signals the end of the program, stops imaging, and disarms all devices.
+ * 
+ * @param imagingTrigger Pulse generator on the imaging trigger pin.
+ */
+void endProgram(PulseGenerator& imagingTrigger) {
+    laser.stopPulses();
+    logStim(laser);                                    // Log a train cut short by the end
+    flushEvents();                                     // Send events still queued
+    Serial.println();
+    Serial.println(F("========== PROGRAM END =========="));
+    Serial.println();
+    imagingTrigger.pulse(IMAGING_TRIGGER_PULSE_WIDTH); // Trigger imaging end
+    leverRH.disarm();
+    leverLH.disarm();
+    cs.disarm();
+    pump.disarm();
+    lickCircuit.disarm();
+    laser.off();
+}
+
+/**
+ * @brief Delivers a reward by activating cue, pump, and laser if armed.
+ * 
+ * Triggers a reward sequence based on the current timestamp and device states.
+ * 
+ * @param lever Reference to a pointer to the Lever object triggering the reward.
+ * @param cue Pointer to the Cue object (optional).
+ * @param pump Pointer to the Pump object (optional).
+ * @param laser Pointer to the Laser object (optional).
+ */
+void deliverReward(Lever*& lever, Cue* cue, Pump* pump, Laser* laser) {
+    int32_t timestamp = static_cast<int32_t>(millis());
+    if (cue && cue->isArmed()) {
+        cue->setOnTimestamp(timestamp);
+        cue->setOffTimestamp(timestamp);
+    }
+    if (pump && pump->isArmed()) {
+        pump->setInfusionPeriod(cue->getOffTimestamp(), traceIntervalLength);
+    }
+    if (laser && laser->isArmed()) {
+        restartStim(*laser, timestamp);
+    }
+}
+
+/**
+ * @brief Checks if a press falls in the reward or post-reward timeout period.
+ * 
+ * The reward period runs from cue onset to the end of the infusion (or the end of
+ * the cue when the pump is not armed); the timeout period follows it.
+ * 
+ * @param timestamp Press time (ms).
+ * @param cue Pointer to the armed Cue object.
+ * @param pump Pointer to the Pump object (optional).
+ * @return Boolean indicating a timeout press.
+ */
+bool isTimeoutPeriod(int32_t timestamp, Cue* cue, Pump* pump) {
+    int32_t rewardEnd = (pump && pump->isArmed()) ? pump->getInfusionEndTimestamp() : cue->getOffTimestamp();
+    return timestamp >= cue->getOnTimestamp() && timestamp <= rewardEnd ||
+           timestamp >= timeoutIntervalStart && timestamp <= timeoutIntervalEnd;
+}
+
+/**
+ * @brief Rewards an active press, logs the infusion and starts the timeout period.
+ * 
+ * @param programRunning Boolean indicating if the program is running.
+ * @param lever Reference to a pointer to the Lever object that earned the reward.
+ * @param cue Pointer to the armed Cue object.
+ * @param pump Pointer to the Pump object (optional).
+ * @param laser Pointer to the Laser object (optional).
+ */
+void rewardActivePress(bool programRunning, Lever*& lever, Cue* cue, Pump* pump, Laser* laser) {
+    deliverReward(lever, cue, pump, laser);
+    if (pump && pump->isArmed()) {
+        logEvent(EVENT_INFUSION, SOURCE_PUMP, DETAIL_NONE,
+                 sessionMicrosFromMillis(pump->getInfusionStartTimestamp()),
+                 sessionMicrosFromMillis(pump->getInfusionEndTimestamp()));
+    }
+    if (programRunning) {
+        timeoutIntervalStart = cue->getOffTimestamp();
+        timeoutIntervalEnd = timeoutIntervalStart + timeoutIntervalLength;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef PROGRAM_UTILS_H
+#define PROGRAM_UTILS_H
+
+#include <Arduino.h>
+#include "Device.h"
+#include "Lever.h"
+#include "Laser.h"
+#include "Pump.h"
+#include "Cue.h"
+#include "PulseGenerator.h"
+
+/**
+ * @file Program_Utils.h
+ * @brief Utility functions for program control and reward delivery.
+ */
+
+const uint32_t IMAGING_TRIGGER_PULSE_WIDTH = 50; ///< Length of the imaging start/stop pulse (ms).
+
+/**
+ * @brief Starts the program and triggers imaging.
+ * @param imagingTrigger Pulse generator on the imaging trigger pin.
+ */
+void startProgram(PulseGenerator& imagingTrigger);
+
+/**
+ * @brief Ends the program and disarms devices.
+ * @param imagingTrigger Pulse generator on the imaging trigger pin.
+ */
+void endProgram(PulseGenerator& imagingTrigger);
+
+/**
+ * @brief Delivers a reward by activating devices.
+ * @param lever Reference to a pointer to the Lever object.
+ * @param cue Pointer to the Cue object (optional).
+ * @param pump Pointer to the Pump object (optional).
+ * @param laser Pointer to the Laser object (optional).
+ */
+void deliverReward(Lever*& lever, Cue* cue, Pump* pump, Laser* laser);
+
+/**
+ * @brief Checks if a press falls in the reward or post-reward timeout period.
+ * @param timestamp Press time (ms).
+ * @param cue Pointer to the armed Cue object.
+ * @param pump Pointer to the Pump object (optional).
+ * @return Boolean indicating a timeout press.
+ */
+bool isTimeoutPeriod(int32_t timestamp, Cue* cue, Pump* pump);
+
+/**
+ * @brief Rewards an active press, logs the infusion and starts the timeout period.
+ * @param programRunning Boolean indicating if the program is running.
+ * @param lever Reference to a pointer to the Lever object.
+ * @param cue Pointer to the armed Cue object.
+ * @param pump Pointer to the Pump object (optional).
+ * @param laser Pointer to the Laser object (optional).
+ */
+void rewardActivePress(bool programRunning, Lever*& lever, Cue* cue, Pump* pump, Laser* laser);
+
+#endif // PROGRAM_UTILS_H
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "PulseGenerator.h"
+#include <Arduino.h>
+
+/**
+ * @brief Constructs an idle PulseGenerator on a pin.
+ * 
+ * @param initPin Output pin.
+ */
+PulseGenerator::PulseGenerator(byte initPin)
+    : pin(initPin), pulseStart(0), pulseWidth(0), active(false) {}
+
+/**
+ * @brief Starts a pulse, restarting any pulse in progress.
+ * 
+ * @param initPulseWidth Pulse length (ms).
+ */
+void PulseGenerator::pulse(uint32_t initPulseWidth) {
+    pulseWidth = initPulseWidth;
+    pulseStart = millis();
+    active = true;
+    digitalWrite(pin, HIGH);
+}
+
+/**
+ * @brief Ends the pulse once its length has elapsed.
+ */
+void PulseGenerator::update() {
+    if (active && millis() - pulseStart >= pulseWidth) {
+        digitalWrite(pin, LOW);
+        active = false;
+    }
+}
+
+/**
+ * @brief Checks if a pulse is in progress.
+ * 
+ * @return Boolean pulse state.
+ */
+bool PulseGenerator::isActive() const {
+    return active;
+}
+
+/**
+ * @brief Gets the output pin.
+ * 
+ * @return The digital pin number (byte).
+ */
+byte PulseGenerator::getPin() const {
+    return pin;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef PULSE_GENERATOR_H
+#define PULSE_GENERATOR_H
+
+#include <Arduino.h>
+
+/**
+ * @file PulseGenerator.h
+ * @brief Defines the PulseGenerator class for timed output pulses without blocking.
+ */
+
+/**
+ * @class PulseGenerator
+ * @brief Drives a pin HIGH for a set time and ends the pulse from update() instead of delay().
+ */
+class PulseGenerator {
+private:
+    const byte pin;      ///< Output pin.
+    uint32_t pulseStart; ///< millis() when the pulse started.
+    uint32_t pulseWidth; ///< Pulse length (ms).
+    bool active;         ///< Indicates whether a pulse is in progress.
+
+public:
+    /**
+     * @brief Constructor for the PulseGenerator class.
+     * @param initPin Output pin.
+     */
+    PulseGenerator(byte initPin);
+
+    /**
+     * @brief Starts a pulse, restarting any pulse in progress.
+     * @param initPulseWidth Pulse length (ms).
+     */
+    void pulse(uint32_t initPulseWidth);
+
+    /**
+     * @brief Ends the pulse once its length has elapsed; call at least once per millisecond.
+     */
+    void update();
+
+    /**
+     * @brief Checks if a pulse is in progress.
+     * @return Boolean pulse state.
+     */
+    bool isActive() const;
+
+    /**
+     * @brief Gets the output pin.
+     * @return The digital pin number (byte).
+     */
+    byte getPin() const;
+};
+
+#endif // PULSE_GENERATOR_H
\ No newline at end of file
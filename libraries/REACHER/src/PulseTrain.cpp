@@ -0,0 +1,504 @@
+#include "PulseTrain.h"
+#include "FastPin.h"
+#include "Timebase.h"
+#include <Arduino.h>
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+#define PULSE_TRAIN_ATOMIC ATOMIC_BLOCK(ATOMIC_RESTORESTATE) ///< Runs a block with interrupts disabled.
+#else
+#define PULSE_TRAIN_ATOMIC ///< Single-threaded targets need no guard.
+#endif
+
+#if defined(__AVR_ATmega328P__)
+#define PULSE_TRAIN_TIMER1 ///< Write edges from the Timer1 compare-A interrupt.
+#endif
+
+#if defined(PULSE_TRAIN_TIMER1) && defined(REACHER_PROFILE)
+const uint32_t TICKS_PER_SECOND = F_CPU;     ///< The profiler runs Timer1 at clk/1.
+#elif defined(PULSE_TRAIN_TIMER1)
+const uint32_t TICKS_PER_SECOND = F_CPU / 8; ///< Timer1 at clk/8.
+#else
+const uint32_t TICKS_PER_SECOND = 1000000;   ///< Edges are timed on the microsecond clock.
+#endif
+const uint32_t TICKS_PER_MICRO = TICKS_PER_SECOND / 1000000; ///< Clock ticks per microsecond.
+const uint32_t TICKS_PER_MILLI = TICKS_PER_SECOND / 1000;    ///< Clock ticks per millisecond.
+const uint32_t MIN_TICKS = PULSE_TRAIN_MIN_INTERVAL * TICKS_PER_MICRO; ///< Shortest pulse or gap (ticks).
+const uint8_t RAMP_STEPS = 128; ///< Steps a ramp-down is divided into.
+
+/**
+ * @brief Pulse width factors of the sinusoidal ramp-down, (1 + cos(pi x)) / 2 in 1/256ths.
+ *
+ * Entry i is the factor at the middle of step i of RAMP_STEPS.
+ */
+static const uint8_t SINE_RAMP[RAMP_STEPS] PROGMEM = {
+    255, 255, 255, 255, 255, 255, 254, 254, 253, 253, 252, 251, 250, 249, 248, 247,
+    246, 244, 243, 242, 240, 239, 237, 235, 234, 232, 230, 228, 226, 224, 222, 220,
+    217, 215, 213, 210, 208, 206, 203, 200, 198, 195, 192, 190, 187, 184, 181, 178,
+    176, 173, 170, 167, 164, 161, 158, 155, 151, 148, 145, 142, 139, 136, 133, 130,
+    126, 123, 120, 117, 114, 111, 108, 105, 101, 98, 95, 92, 89, 86, 83, 80,
+    78, 75, 72, 69, 66, 64, 61, 58, 56, 53, 50, 48, 46, 43, 41, 39,
+    36, 34, 32, 30, 28, 26, 24, 22, 21, 19, 17, 16, 14, 13, 12, 10,
+    9, 8, 7, 6, 5, 4, 3, 3, 2, 2, 1, 1, 0, 0, 0, 0
+};
+
+/**
+ * @struct CompletedTrain
+ * @brief A train waiting in the queue.
+ */
+struct CompletedTrain {
+    uint64_t start;  ///< First rising edge on the timebase clock (us).
+    uint32_t length; ///< First rising to last falling edge (ticks).
+};
+
+// Shape, fixed while a waveform runs (ticks unless noted)
+static uint32_t frequencyHz = 1;            ///< Pulses per second.
+static uint32_t periodTicks = 0;            ///< Whole ticks per pulse period.
+static uint32_t periodRemainder = 0;        ///< Fraction of a tick per period, in 1/frequency ticks.
+static uint32_t widthTicks = 0;             ///< Pulse width before the ramp.
+static uint32_t burstPulses = 0;            ///< Pulses per burst.
+static uint32_t burstPeriodTicks = 0;       ///< Burst onset to onset.
+static uint32_t burstsPerTrain = 0;         ///< Bursts per train.
+static uint32_t trainPeriodTicks = 0;       ///< Train onset to onset.
+static RAMP rampShape = RAMP_NONE;          ///< Ramp-down shape.
+static uint32_t rampStartTicks = 0;         ///< Start of the ramp-down, from the train's first edge.
+static uint8_t rampShift = 0;               ///< Right shift bringing ramp offsets under 16 bits.
+static uint32_t rampScale = 0;              ///< Converts shifted ramp offsets to steps, in 1/65536ths.
+static uint32_t maxTrainPulses = 0;         ///< Most pulses that fit in one train of at most 2^32 ticks.
+
+// Position of the edge being generated
+static uint32_t remainderSum = 0;           ///< Accumulated fractions, in 1/frequency ticks.
+static volatile uint32_t pulsesLeft = 0;    ///< Pulses of the burst not yet ended, including the current one.
+static uint32_t burstsLeft = 0;             ///< Bursts of the train not yet ended, including the current one.
+static uint32_t trainsLeft = 0;             ///< Trains not yet ended, including the current one.
+static uint32_t extraPulses = 0;            ///< Pulses added past the longest train, played as further trains.
+static uint64_t trainOnset = 0;             ///< Start of the current train, from the waveform's first edge.
+static uint32_t burstOnset = 0;             ///< Start of the current burst, from the train's first edge.
+static uint32_t pulseOnset = 0;             ///< Start of the current pulse, from the train's first edge.
+static uint32_t pulseWidth = 0;             ///< Width of the current pulse, after the ramp.
+static uint32_t edgeInTrain = 0;            ///< Time of the edge now due, from the train's first edge.
+static bool atOnset = false;                ///< Whether the edge now due starts a pulse.
+static volatile bool running = false;       ///< Whether a waveform is running.
+static uint64_t edgeTicks = 0;              ///< Time of the edge now due, from the waveform's first edge.
+static uint64_t startMicros = 0;            ///< First rising edge on the timebase clock (us).
+
+// Completed trains
+static CompletedTrain completed[PULSE_TRAIN_QUEUE_SIZE]; ///< Trains waiting to be read.
+static volatile uint8_t completedHead = 0;  ///< Index of the oldest queued train.
+static volatile uint8_t completedCount = 0; ///< Number of queued trains.
+
+#if defined(PULSE_TRAIN_TIMER1)
+
+static uint32_t ticksToEdge = 0;               ///< Ticks from the scheduled compare match to the edge.
+const uint16_t COMPARE_GUARD = 2 * TICKS_PER_MICRO; ///< Compare matches closer than this are handled at once.
+
+#endif
+
+/**
+ * @brief Drives the pin.
+ * @param level True for high, false for low.
+ */
+static inline void writePin(bool level) {
+    FastPin<PULSE_TRAIN_PIN>::write(level);
+}
+
+/**
+ * @brief Works out the width of a pulse under the ramp-down.
+ *
+ * Pulses starting before the ramp keep their full width. Later ones are scaled by the
+ * ramp factor at their onset, and one narrowed below PULSE_TRAIN_MIN_INTERVAL ends
+ * the train.
+ *
+ * @param onset Start of the pulse, from the train's first edge (ticks).
+ * @return Width in ticks, or 0 if the pulse is dropped.
+ */
+static inline uint32_t rampedWidth(uint32_t onset) {
+    if (rampShape == RAMP_NONE || onset < rampStartTicks) {
+        return widthTicks;
+    }
+    uint32_t step = (((onset - rampStartTicks) >> rampShift) * rampScale) >> 16;
+    if (step >= RAMP_STEPS) {
+        return 0;
+    }
+    uint8_t factor = rampShape == RAMP_LINEAR ? static_cast<uint8_t>(255 - 2 * step)
+                                              : pgm_read_byte(&SINE_RAMP[step]);
+    uint32_t width = (widthTicks * factor) >> 8;
+    return width >= MIN_TICKS ? width : 0;
+}
+
+/**
+ * @brief Queues the current train as completed.
+ * @param length First rising to last falling edge (ticks).
+ */
+static inline void queueTrain(uint32_t length) {
+    if (completedCount < PULSE_TRAIN_QUEUE_SIZE) {
+        uint8_t tail = (completedHead + completedCount) % PULSE_TRAIN_QUEUE_SIZE;
+        completed[tail].start = startMicros + trainOnset / TICKS_PER_MICRO;
+        completed[tail].length = length;
+        completedCount++;
+    }
+}
+
+/**
+ * @brief Moves to the first pulse of the current train.
+ */
+static inline void beginTrain() {
+    pulsesLeft = burstPulses;
+    burstsLeft = burstsPerTrain;
+    remainderSum = 0;
+    burstOnset = 0;
+    pulseOnset = 0;
+    edgeInTrain = 0;
+    pulseWidth = rampedWidth(0);
+    atOnset = true;
+}
+
+/**
+ * @brief Ends a lengthened train at its limit and carries on with the rest in a new one.
+ *
+ * The new train starts where the next pulse would have, so the pulses keep their
+ * period; with no gap between pulses the pin stays high across the two trains. The
+ * ended train is queued, and each is logged as its own train.
+ *
+ * @return Ticks to the next edge.
+ */
+static inline uint32_t continueTrain() {
+    uint32_t period = periodTicks + (remainderSum + periodRemainder >= frequencyHz ? 1 : 0);
+    uint32_t gap = pulseOnset + period - edgeInTrain;
+    if (gap >= MIN_TICKS) {
+        writePin(false);
+    }
+    queueTrain(edgeInTrain);
+    trainOnset += static_cast<uint64_t>(pulseOnset) + period; // Past 2^32 ticks: add in 64 bits
+    burstPulses = extraPulses < maxTrainPulses ? extraPulses : maxTrainPulses;
+    extraPulses -= burstPulses;
+    beginTrain();
+    if (gap < MIN_TICKS) { // No gap: stay high into the first pulse of the new train
+        atOnset = false;
+        edgeInTrain = pulseWidth;
+        return gap + pulseWidth;
+    }
+    return gap;
+}
+
+/**
+ * @brief Writes the edge that is due and works out when the next one is.
+ *
+ * Pulses that leave no gap, or one too short to time, keep the pin high through to
+ * the next pulse, so an unbroken high output is a burst with width equal to the period.
+ *
+ * @return Ticks to the next edge, or 0 once the waveform has ended.
+ */
+static inline uint32_t writeEdge() {
+    if (atOnset) {
+        writePin(true);
+        atOnset = false;
+        edgeInTrain = pulseOnset + pulseWidth;
+        return pulseWidth;
+    }
+
+    // The current pulse ends here; find the next one in this train
+    uint32_t nextWidth = 0;
+    if (--pulsesLeft > 0) {
+        uint32_t period = periodTicks;
+        remainderSum += periodRemainder;
+        if (remainderSum >= frequencyHz) {
+            remainderSum -= frequencyHz;
+            period++;
+        }
+        pulseOnset += period;
+        nextWidth = rampedWidth(pulseOnset);
+    } else if (--burstsLeft > 0) {
+        pulsesLeft = burstPulses;
+        remainderSum = 0;
+        burstOnset += burstPeriodTicks;
+        pulseOnset = burstOnset;
+        nextWidth = rampedWidth(pulseOnset);
+    }
+    if (nextWidth > 0) {
+        uint32_t gap = pulseOnset - edgeInTrain;
+        pulseWidth = nextWidth;
+        if (gap < MIN_TICKS) {
+            edgeInTrain = pulseOnset + pulseWidth; // No gap: stay high into the next pulse
+            return gap + pulseWidth;
+        }
+        writePin(false);
+        atOnset = true;
+        edgeInTrain = pulseOnset;
+        return gap;
+    }
+
+    // The train ends here
+    if (extraPulses > 0) {
+        return continueTrain();
+    }
+    writePin(false);
+    queueTrain(edgeInTrain);
+    if (--trainsLeft == 0) {
+        running = false;
+        return 0;
+    }
+    uint32_t gap = trainPeriodTicks - edgeInTrain;
+    trainOnset += trainPeriodTicks;
+    beginTrain();
+    return gap;
+}
+
+#if defined(PULSE_TRAIN_TIMER1)
+
+/**
+ * @brief Moves the compare match towards the next edge.
+ *
+ * Intervals longer than Timer1's 16-bit range are covered in half-range steps.
+ */
+static inline void scheduleCompare() {
+    uint16_t step = ticksToEdge > 0xFFFF ? 0x8000 : static_cast<uint16_t>(ticksToEdge);
+    OCR1A += step;
+    ticksToEdge -= step;
+}
+
+/**
+ * @brief Writes an edge, or steps towards it, on the Timer1 compare match.
+ *
+ * An edge scheduled too close to the counter to be matched is written at once
+ * rather than missed for a full timer period.
+ */
+ISR(TIMER1_COMPA_vect) {
+    do {
+        if (ticksToEdge == 0) {
+            uint32_t interval = writeEdge();
+            if (interval == 0) {
+                TIMSK1 &= ~_BV(OCIE1A);
+                return;
+            }
+            edgeTicks += interval;
+            ticksToEdge = interval;
+        }
+        scheduleCompare();
+    } while (static_cast<int16_t>(OCR1A - TCNT1) < static_cast<int16_t>(COMPARE_GUARD));
+    TIFR1 = _BV(OCF1A); // Drop a match passed while catching up
+}
+
+/**
+ * @brief Starts Timer1.
+ *
+ * Timer1 is left alone when the timebase or the profiler already runs it.
+ */
+void pulseTrainBegin() {
+#if !defined(TIMEBASE_INPUT_CAPTURE) && !defined(REACHER_PROFILE)
+    PULSE_TRAIN_ATOMIC {
+        TCCR1A = 0;
+        TCCR1B = _BV(CS11); // Normal mode, clk/8
+    }
+#endif
+}
+
+#else
+
+/**
+ * @brief Starts the engine; edges are timed on the microsecond clock.
+ */
+void pulseTrainBegin() {
+}
+
+#endif
+
+/**
+ * @brief Works out the length of a burst.
+ * @param waveform Waveform.
+ * @return First rising to last falling edge of a burst (ticks).
+ */
+static uint64_t burstLength(const Waveform& waveform) {
+    uint64_t steps = waveform.pulses - 1;
+    uint64_t period = TICKS_PER_SECOND / waveform.frequency;
+    uint64_t remainder = TICKS_PER_SECOND % waveform.frequency;
+    return steps * period + steps * remainder / waveform.frequency +
+           static_cast<uint64_t>(waveform.width) * TICKS_PER_MICRO;
+}
+
+/**
+ * @brief Works out the length of a train.
+ * @param waveform Waveform.
+ * @return First rising to last falling edge of a train before any ramp (ticks).
+ */
+static uint64_t trainLength(const Waveform& waveform) {
+    return static_cast<uint64_t>(waveform.bursts - 1) * waveform.burstPeriod * TICKS_PER_MILLI +
+           burstLength(waveform);
+}
+
+/**
+ * @brief Checks whether a waveform can be generated.
+ * @param waveform Waveform to check.
+ * @return True if the pulses, bursts, trains and ramp fit and can be timed.
+ */
+bool pulseTrainValid(const Waveform& waveform) {
+    if (waveform.frequency == 0 || waveform.frequency > TICKS_PER_SECOND ||
+        waveform.width < PULSE_TRAIN_MIN_INTERVAL || waveform.width > 0xFFFFFFFFUL / TICKS_PER_MICRO) {
+        return false;
+    }
+    if (waveform.pulses == 0 || waveform.bursts == 0 || waveform.trains == 0 ||
+        waveform.ramp > RAMP_SINE) {
+        return false;
+    }
+    uint32_t period = TICKS_PER_SECOND / waveform.frequency;
+    uint32_t ticks = waveform.width * TICKS_PER_MICRO;
+    if (ticks > period || (ticks < period && period - ticks < MIN_TICKS)) {
+        return false;
+    }
+    uint64_t burst = burstLength(waveform);
+    uint64_t train = trainLength(waveform);
+    if (train > 0xFFFFFFFFUL) {
+        return false;
+    }
+    if (waveform.bursts > 1 &&
+        static_cast<uint64_t>(waveform.burstPeriod) * TICKS_PER_MILLI < burst + MIN_TICKS) {
+        return false;
+    }
+    if (waveform.trains > 1 &&
+        static_cast<uint64_t>(waveform.trainPeriod) * TICKS_PER_MILLI < train + MIN_TICKS) {
+        return false;
+    }
+    if (waveform.ramp != RAMP_NONE &&
+        (waveform.rampDuration == 0 || static_cast<uint64_t>(waveform.rampDuration) * TICKS_PER_MILLI > train)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Starts a waveform, replacing any waveform already running.
+ * @param waveform Waveform to generate.
+ * @return True if started.
+ */
+bool pulseTrainStart(const Waveform& waveform) {
+    if (!pulseTrainValid(waveform)) {
+        return false;
+    }
+    pulseTrainStop();
+    uint32_t train = static_cast<uint32_t>(trainLength(waveform));
+    PULSE_TRAIN_ATOMIC {
+        frequencyHz = waveform.frequency;
+        periodTicks = TICKS_PER_SECOND / waveform.frequency;
+        periodRemainder = TICKS_PER_SECOND % waveform.frequency;
+        widthTicks = waveform.width * TICKS_PER_MICRO;
+        burstPulses = waveform.pulses;
+        burstPeriodTicks = waveform.burstPeriod * TICKS_PER_MILLI;
+        burstsPerTrain = waveform.bursts;
+        trainPeriodTicks = waveform.trainPeriod * TICKS_PER_MILLI;
+        rampShape = waveform.ramp;
+        if (rampShape != RAMP_NONE) {
+            uint32_t rampTicks = waveform.rampDuration * TICKS_PER_MILLI;
+            rampStartTicks = train - rampTicks;
+            rampShift = 0;
+            while ((rampTicks >> rampShift) > 0xFFFF) {
+                rampShift++;
+            }
+            rampScale = (static_cast<uint32_t>(RAMP_STEPS) << 16) / (rampTicks >> rampShift);
+        }
+        maxTrainPulses = (0xFFFFFFFFUL - widthTicks) / (periodTicks + (periodRemainder ? 1 : 0)) + 1;
+        extraPulses = 0;
+        trainsLeft = waveform.trains;
+        trainOnset = 0;
+        beginTrain(); // Trains still queued keep their own times
+        edgeTicks = 0;
+        running = true;
+        startMicros = timebaseMicros() + PULSE_TRAIN_MIN_INTERVAL;
+#if defined(PULSE_TRAIN_TIMER1)
+        ticksToEdge = 0;
+        OCR1A = TCNT1 + MIN_TICKS;
+        TIFR1 = _BV(OCF1A);
+        TIMSK1 |= _BV(OCIE1A);
+#endif
+    }
+    return true;
+}
+
+/**
+ * @brief Adds pulses to the end of the running waveform.
+ *
+ * Pulses that would take the train past 2^32 ticks, where its times would wrap, are
+ * held back and played as further trains (see continueTrain()).
+ *
+ * @param pulses Pulses to add.
+ */
+void pulseTrainExtend(uint32_t pulses) {
+    PULSE_TRAIN_ATOMIC {
+        if (running && burstsPerTrain == 1 && trainsLeft == 1 && rampShape == RAMP_NONE) {
+            uint32_t room = maxTrainPulses > burstPulses ? maxTrainPulses - burstPulses : 0;
+            uint32_t added = pulses < room ? pulses : room;
+            burstPulses += added;
+            pulsesLeft += added;
+            uint32_t held = pulses - added;
+            extraPulses = held < 0xFFFFFFFFUL - extraPulses ? extraPulses + held : 0xFFFFFFFFUL;
+        }
+    }
+}
+
+/**
+ * @brief Stops the running waveform at once and drives the pin low.
+ */
+void pulseTrainStop() {
+    PULSE_TRAIN_ATOMIC {
+        if (running) {
+#if defined(PULSE_TRAIN_TIMER1)
+            TIMSK1 &= ~_BV(OCIE1A);
+#endif
+            writePin(false);
+            running = false;
+            uint64_t now = timebaseMicros();
+            uint64_t elapsed = now > startMicros ? (now - startMicros) * TICKS_PER_MICRO : 0;
+            uint64_t trainStart = trainOnset;
+            if (elapsed > trainStart && (!atOnset || pulseOnset > 0)) { // Cut short after its first edge
+                queueTrain(static_cast<uint32_t>(elapsed - trainStart));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Checks whether a waveform is running.
+ * @return True until the last falling edge of the waveform.
+ */
+bool pulseTrainRunning() {
+    return running;
+}
+
+/**
+ * @brief Takes the oldest completed train from the queue.
+ * @param start Set to the time of the train's first rising edge on the timebase clock (us).
+ * @param end Set to the time of the train's last falling edge on the timebase clock (us).
+ * @return True if a train was taken.
+ */
+bool pulseTrainNextTrain(uint64_t& start, uint64_t& end) {
+    CompletedTrain train;
+    PULSE_TRAIN_ATOMIC {
+        if (completedCount == 0) {
+            return false;
+        }
+        train = completed[completedHead];
+        completedHead = (completedHead + 1) % PULSE_TRAIN_QUEUE_SIZE;
+        completedCount--;
+    }
+    start = train.start;
+    end = train.start + train.length / TICKS_PER_MICRO;
+    return true;
+}
+
+/**
+ * @brief Writes every edge that has come due on the microsecond clock.
+ */
+void pulseTrainUpdate() {
+#if !defined(PULSE_TRAIN_TIMER1)
+    if (!running) {
+        return;
+    }
+    uint64_t now = timebaseMicros();
+    if (now < startMicros) {
+        return;
+    }
+    uint64_t elapsed = now - startMicros;
+    while (running && elapsed >= edgeTicks) {
+        edgeTicks += writeEdge();
+    }
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#ifndef PULSE_TRAIN_H
+#define PULSE_TRAIN_H
+
+#include <Arduino.h>
+
+/**
+ * @file PulseTrain.h
+ * @brief Timer-driven waveform engine on one output pin, used for laser stimulation.
+ *
+ * A waveform is described by a Waveform: pulses of a fixed width at a fixed frequency
+ * are grouped into bursts, bursts into trains, and trains are repeated, each level
+ * at its own onset-to-onset period. Each train can end in a linear or sinusoidal
+ * ramp-down, which narrows the pulses over its last milliseconds. A plain pulse
+ * train is one burst in one train.
+ *
+ * Every edge is scheduled on a clock rather than noticed by loop(), so the waveform
+ * does not drift or jitter with loop load. Bursts and trains start at whole multiples
+ * of their period from the waveform's first edge. Pulse periods that are not a whole
+ * number of clock ticks are spread with a remainder accumulator, so the mean frequency
+ * is exact and every edge is within one tick of its ideal time.
+ *
+ * On an ATmega328P the edges are written by the Timer1 compare-A interrupt, with
+ * OCR1A stepped from one edge to the next, as single sbi/cbi instructions on
+ * PULSE_TRAIN_PIN (see FastPin.h). The laser pin (6) is not a Timer1 output,
+ * so the edge lags the compare match by the interrupt latency: a constant offset,
+ * plus jitter only when another interrupt is being serviced. Timer1 free-runs in
+ * normal mode at clk/8 (0.5 us ticks); with TIMEBASE_INPUT_CAPTURE it is shared with
+ * the timebase at the same rate, or with REACHER_PROFILE with the profiler at clk/1
+ * (the two cannot be enabled together).
+ * Other targets, including the host build, generate the edges from
+ * pulseTrainUpdate() on the microsecond clock.
+ *
+ * Each completed train is queued with the times of its first rising and last falling
+ * edge on the timebase clock (see Timebase.h), to be logged as one event per train.
+ */
+
+const uint8_t PULSE_TRAIN_PIN = 6;            ///< Output pin (the laser's); fixed at compile time so each edge is one port write.
+const uint32_t PULSE_TRAIN_MIN_INTERVAL = 20; ///< Shortest pulse or gap between pulses (us).
+const uint8_t PULSE_TRAIN_QUEUE_SIZE = 4;     ///< Completed trains held until read.
+
+/**
+ * @enum RAMP
+ * @brief Shapes of the ramp-down at the end of each train.
+ */
+enum RAMP : uint8_t { RAMP_NONE,   ///< Pulses keep their width to the end of the train.
+                      RAMP_LINEAR, ///< Pulse width falls linearly to zero.
+                      RAMP_SINE    ///< Pulse width follows a half cosine to zero.
+};
+
+/**
+ * @struct Waveform
+ * @brief Descriptor of a stimulation waveform.
+ */
+struct Waveform {
+    uint32_t frequency;    ///< Pulses per second within a burst (Hz).
+    uint32_t width;        ///< Pulse width (us); equal to the period for an unbroken high output.
+    uint32_t pulses;       ///< Pulses per burst.
+    uint32_t burstPeriod;  ///< Burst onset to onset (ms); unused with one burst per train.
+    uint32_t bursts;       ///< Bursts per train.
+    uint32_t trainPeriod;  ///< Train onset to onset (ms); unused with one train.
+    uint32_t trains;       ///< Number of trains.
+    RAMP ramp;             ///< Ramp-down at the end of each train.
+    uint32_t rampDuration; ///< Length of the ramp-down (ms).
+};
+
+/**
+ * @brief Starts the engine's clock.
+ *
+ * PULSE_TRAIN_PIN must already be configured as an output.
+ */
+void pulseTrainBegin();
+
+/**
+ * @brief Checks whether a waveform can be generated.
+ *
+ * Pulses and the gaps between them must be at least PULSE_TRAIN_MIN_INTERVAL, or
+ * the width must fill the period exactly. A burst must end PULSE_TRAIN_MIN_INTERVAL
+ * before the next one starts, and likewise a train; the ramp must fit in a train.
+ * A train may last at most 2^32 clock ticks (~35 min, or ~4.5 min with REACHER_PROFILE).
+ *
+ * @param waveform Waveform to check.
+ * @return True if the waveform can be generated.
+ */
+bool pulseTrainValid(const Waveform& waveform);
+
+/**
+ * @brief Starts a waveform, replacing any waveform already running.
+ *
+ * The first rising edge follows PULSE_TRAIN_MIN_INTERVAL after the call. Trains not
+ * yet read with pulseTrainNextTrain(), including one cut short by the restart, stay
+ * queued with their own times.
+ *
+ * @param waveform Waveform to generate.
+ * @return True if started, false if the waveform fails pulseTrainValid().
+ */
+bool pulseTrainStart(const Waveform& waveform);
+
+/**
+ * @brief Adds pulses to the end of the running waveform.
+ *
+ * Only a single burst without a ramp can be lengthened; other waveforms are left as
+ * they are. Pulses past the longest train (2^32 clock ticks) carry on, at the same
+ * period, in a new train that is queued and logged separately.
+ *
+ * @param pulses Pulses to add.
+ */
+void pulseTrainExtend(uint32_t pulses);
+
+/**
+ * @brief Stops the running waveform at once and drives the pin low.
+ *
+ * A train cut short is queued as completed, ending at the time of the call.
+ */
+void pulseTrainStop();
+
+/**
+ * @brief Checks whether a waveform is running.
+ * @return True until the last falling edge of the waveform.
+ */
+bool pulseTrainRunning();
+
+/**
+ * @brief Takes the oldest completed train from the queue.
+ *
+ * Trains completed while the queue is full are dropped.
+ *
+ * @param start Set to the time of the train's first rising edge on the timebase clock (us).
+ * @param end Set to the time of the train's last falling edge on the timebase clock (us).
+ * @return True if a train was taken, false if the queue is empty.
+ */
+bool pulseTrainNextTrain(uint64_t& start, uint64_t& end);
+
+/**
+ * @brief Writes the edges that are due on targets without the Timer1 engine.
+ *
+ * Does nothing on an ATmega328P, where the edges come from the timer interrupt.
+ */
+void pulseTrainUpdate();
+
+#endif // PULSE_TRAIN_H
\ No newline at end of file
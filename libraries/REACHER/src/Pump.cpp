@@ -10,7 +10,7 @@
  * @param initPin The digital pin (byte) to which the pump is connected.
  */
 Pump::Pump(byte initPin) 
-    : Device(initPin), running(false), infusionDuration(2000), infusionAmount(0.0f), 
+    : Device(initPin), outputOn(false), running(false), infusionDuration(2000), infusionAmount(0.0f), 
       motorRPMs(0.0f), infusionStartTimestamp(0), infusionEndTimestamp(0) {}
 
 /**
@@ -55,18 +55,40 @@ void Pump::setInfusionPeriod(int32_t cueOffTimestamp, int32_t traceInterval) {
     infusionEndTimestamp = infusionStartTimestamp + infusionDuration;
 }
 
+/**
+ * @brief Records the level the pump pin is to be driven to.
+ * @param level True for high, false for low.
+ * @return Boolean indicating the level changed and the pin must be written.
+ */
+bool Pump::switchOutput(bool level) {
+    if (outputOn == level) {
+        return false;
+    }
+    outputOn = level;
+    return true;
+}
+
 /**
  * @brief Turns the pump on.
+ * 
+ * managePump() calls this on every pass of an infusion, so the pin is only written
+ * when the pump was off.
  */
 void Pump::on() {
-    digitalWrite(pin, HIGH);
+    if (switchOutput(true)) {
+        digitalWrite(pin, HIGH);
+    }
 }
 
 /**
  * @brief Turns the pump off.
+ * 
+ * Only writes the pin when the pump was on.
  */
 void Pump::off() {
-    digitalWrite(pin, LOW);
+    if (switchOutput(false)) {
+        digitalWrite(pin, LOW);
+    }
 }
 
 /**
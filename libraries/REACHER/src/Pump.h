@@ -16,6 +16,20 @@
  * Manages pump state, infusion timing, and motor settings.
  */
 class Pump : public Device {
+private:
+    bool outputOn;                ///< Level the pump pin is driven to (true for high).
+
+protected:
+    /**
+     * @brief Records the level the pump pin is to be driven to.
+     *
+     * on() and off(), and FastPump's, write the pin only when this returns true.
+     *
+     * @param level True for high, false for low.
+     * @return Boolean indicating the level changed and the pin must be written.
+     */
+    bool switchOutput(bool level);
+
 public:
     bool running;                 ///< Indicates if the pump is running.
     int32_t infusionDuration;     ///< Duration of infusion (ms).
@@ -62,12 +76,12 @@ public:
     void setInfusionPeriod(int32_t cueOffTimestamp, int32_t traceInterval);
 
     /**
-     * @brief Turns the pump on.
+     * @brief Turns the pump on; writes the pin only if the pump is off.
      */
     void on();
 
     /**
-     * @brief Turns the pump off.
+     * @brief Turns the pump off; writes the pin only if the pump is on.
      */
     void off();
 
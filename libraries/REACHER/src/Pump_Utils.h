@@ -1,14 +1,24 @@
-#include "Pump.h"
+#ifndef PUMP_UTILS_H
+#define PUMP_UTILS_H
+
 #include <Arduino.h>
+#include "Pump.h"
 
 /**
- * @brief Controls pump operation based on infusion timestamps.
+ * @file Pump_Utils.h
+ * @brief Utility function for managing pump operation.
+ */
+
+/**
+ * @brief Manages pump on/off state based on infusion period.
  * 
- * Turns the pump on during the infusion period and off otherwise, if armed.
+ * Turns the pump on during the infusion period and off otherwise, if armed. A template
+ * so a FastPump is switched through its own on() and off(), not Pump's.
  * 
- * @param pump Pointer to the Pump object (optional, can be nullptr).
+ * @param pump Pointer to the Pump or FastPump object (optional, can be nullptr).
  */
-void managePump(Pump* pump) {
+template <class PumpType>
+void managePump(PumpType* pump) {
     int32_t timestamp = static_cast<int32_t>(millis());
     if (pump && pump->isArmed()) {
         if (timestamp <= pump->getInfusionEndTimestamp() && timestamp >= pump->getInfusionStartTimestamp()) {
@@ -19,4 +29,6 @@ void managePump(Pump* pump) {
             pump->setRunning(false);
         }
     }
-}
\ No newline at end of file
+}
+
+#endif // PUMP_UTILS_H
@@ -0,0 +1,19 @@
+#ifndef REACHER_H
+#define REACHER_H
+
+/**
+ * @file REACHER.h
+ * @brief Single include for paradigm sketches built on the REACHER core.
+ *
+ * A paradigm sketch includes this header, calls sessionSetup() and sessionLoop()
+ * from setup() and loop(), and implements the schedule interface in Schedule.h.
+ */
+
+#include <Arduino.h>
+#include "Session.h"
+#include "Schedule.h"
+#include "Program_Utils.h"
+#include "Event_Utils.h"
+#include "Timebase.h"
+
+#endif // REACHER_H
\ No newline at end of file
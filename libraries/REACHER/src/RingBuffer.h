@@ -0,0 +1,135 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <Arduino.h>
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+#define RING_BUFFER_ATOMIC ATOMIC_BLOCK(ATOMIC_RESTORESTATE) ///< Runs a block with interrupts disabled.
+#else
+#define RING_BUFFER_ATOMIC ///< Single-threaded targets need no guard.
+#endif
+
+/**
+ * @file RingBuffer.h
+ * @brief Defines a lock-free single-producer/single-consumer ring buffer.
+ * 
+ * The producer only ever writes the head index and the consumer only ever writes
+ * the tail index, so one side may run inside an interrupt service routine while
+ * the other runs in loop() without disabling interrupts.
+ */
+
+/**
+ * @class RingBuffer
+ * @brief Fixed-capacity SPSC queue of trivially copyable items.
+ * 
+ * Holds up to SIZE - 1 items. When full, push() rejects the item and counts it
+ * as dropped instead of blocking or overwriting older entries.
+ * 
+ * @tparam T Item type.
+ * @tparam SIZE Number of slots; must be a power of two no larger than 128.
+ */
+template <typename T, uint8_t SIZE>
+class RingBuffer {
+    static_assert(SIZE >= 2 && SIZE <= 128 && (SIZE & (SIZE - 1)) == 0,
+                  "RingBuffer SIZE must be a power of two between 2 and 128");
+
+private:
+    T items[SIZE];             ///< Item storage.
+    volatile uint8_t head;     ///< Next slot to write (producer only).
+    volatile uint8_t tail;     ///< Next slot to read (consumer only).
+    volatile uint16_t dropped; ///< Items rejected because the buffer was full (producer only).
+
+public:
+    /**
+     * @brief Constructs an empty ring buffer.
+     */
+    RingBuffer() : head(0), tail(0), dropped(0) {}
+
+    /**
+     * @brief Appends an item (producer side).
+     * @param item Item to copy into the buffer.
+     * @return True if stored, false if the buffer was full and the item was dropped.
+     */
+    bool push(const T& item) {
+        uint8_t next = (head + 1) & (SIZE - 1);
+        if (next == tail) {
+            dropped++;
+            return false;
+        }
+        items[head] = item;
+        __asm__ __volatile__("" ::: "memory"); // Publish the item before the index
+        head = next;
+        return true;
+    }
+
+    /**
+     * @brief Copies the oldest item without removing it (consumer side).
+     * @param item Destination for the item.
+     * @return True if an item was available.
+     */
+    bool peek(T& item) const {
+        if (tail == head) {
+            return false;
+        }
+        item = items[tail];
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item (consumer side).
+     * @param item Destination for the item.
+     * @return True if an item was available.
+     */
+    bool pop(T& item) {
+        if (!peek(item)) {
+            return false;
+        }
+        __asm__ __volatile__("" ::: "memory"); // Finish reading before releasing the slot
+        tail = (tail + 1) & (SIZE - 1);
+        return true;
+    }
+
+    /**
+     * @brief Checks if the buffer holds no items.
+     * @return Boolean indicating an empty buffer.
+     */
+    bool isEmpty() const {
+        return tail == head;
+    }
+
+    /**
+     * @brief Checks if the buffer has no free slot.
+     * @return Boolean indicating a full buffer.
+     */
+    bool isFull() const {
+        return ((head + 1) & (SIZE - 1)) == tail;
+    }
+
+    /**
+     * @brief Gets the number of items currently stored.
+     * @return Item count.
+     */
+    uint8_t count() const {
+        return (head - tail) & (SIZE - 1);
+    }
+
+    /**
+     * @brief Gets the total number of items dropped because the buffer was full.
+     *
+     * Briefly disables interrupts so the 16-bit counter is read atomically, then
+     * restores the previous interrupt state, so it is safe inside a critical section
+     * or an ISR.
+     *
+     * @return Dropped item count.
+     */
+    uint16_t getDropped() const {
+        uint16_t total;
+        RING_BUFFER_ATOMIC {
+            total = dropped;
+        }
+        return total;
+    }
+};
+
+#endif // RING_BUFFER_H
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "Lever.h"
+#include "Cue.h"
+#include "Pump.h"
+#include "Laser.h"
+#include "Command_Utils.h"
+
+/**
+ * @file Schedule.h
+ * @brief Interface every paradigm sketch implements on top of the REACHER core.
+ *
+ * The core (Session.h) owns the devices, the event log, the scheduler and the
+ * shared serial commands. A paradigm (fixed ratio, variable interval, ...) only
+ * defines the functions and tables declared here, typically in its .ino file.
+ */
+
+/**
+ * @brief Labels a debounced lever press and triggers the schedule's consequences.
+ *
+ * Called for both levers; the inactive lever is passed without devices.
+ *
+ * @param programRunning Boolean indicating if the program is running.
+ * @param lever Reference to a pointer to the pressed Lever object.
+ * @param cue Pointer to the Cue object (nullptr for the inactive lever).
+ * @param pump Pointer to the Pump object (nullptr for the inactive lever).
+ * @param laser Pointer to the Laser object (nullptr for the inactive lever).
+ */
+void definePressActivity(bool programRunning, Lever*& lever, Cue* cue, Pump* pump, Laser* laser);
+
+/**
+ * @brief Resets the schedule's state at "START-PROGRAM", after the session epoch is set.
+ */
+void scheduleStart();
+
+/**
+ * @brief Runs the schedule's periodic work once per scheduler tick while linked to the GUI.
+ */
+void scheduleTask();
+
+/**
+ * @brief Adds the schedule's settings to the setup JSON sent at "START-PROGRAM".
+ * @param doc JSON document being built.
+ */
+void scheduleSettings(JsonDocument& doc);
+
+extern const Command scheduleCommands[];  ///< Schedule-specific commands in PROGMEM, sorted by prefix.
+extern const size_t SCHEDULE_COMMAND_COUNT; ///< Number of schedule-specific commands.
+
+#endif // SCHEDULE_H
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "Scheduler.h"
+#include <Arduino.h>
+
+#if defined(__AVR__) && defined(TIMSK0) && defined(OCIE0A)
+#define SCHEDULER_TIMER0_TICK ///< Tick from the Timer0 compare-A interrupt.
+#endif
+
+/**
+ * @struct ScheduledTask
+ * @brief A registered task and its timing statistics.
+ */
+struct ScheduledTask {
+    const __FlashStringHelper* name; ///< Task name.
+    void (*run)();                   ///< Function to run.
+    uint16_t period;                 ///< Period in ticks.
+    uint16_t countdown;              ///< Ticks until the task is next due.
+    uint8_t priority;                ///< Run order within a tick; lower runs first.
+    uint32_t runs;                   ///< Number of times the task has run.
+    uint32_t worstCase;              ///< Longest execution time seen (us).
+};
+
+static ScheduledTask tasks[MAX_SCHEDULED_TASKS]; ///< Tasks sorted by priority.
+static uint8_t taskCount = 0;                    ///< Number of registered tasks.
+static uint32_t missedTicks = 0;                 ///< Ticks folded into a later pass.
+
+#if defined(SCHEDULER_TIMER0_TICK)
+
+static volatile uint8_t pendingTicks = 0; ///< Ticks raised since the last pass.
+
+/**
+ * @brief Raises a scheduler tick once per Timer0 overflow period (~1.024 ms).
+ */
+ISR(TIMER0_COMPA_vect) {
+    if (pendingTicks < 0xFF) {
+        pendingTicks++;
+    }
+}
+
+/**
+ * @brief Starts the scheduler tick on the Timer0 compare-A interrupt.
+ *
+ * Timer0 keeps running for millis(); only the compare interrupt is enabled.
+ */
+void schedulerBegin() {
+    noInterrupts();
+    OCR0A = 0x80;
+    TIMSK0 |= _BV(OCIE0A);
+    interrupts();
+}
+
+/**
+ * @brief Takes the ticks raised since the previous pass.
+ *
+ * @return Number of ticks.
+ */
+static uint16_t takeTicks() {
+    noInterrupts();
+    uint8_t ticks = pendingTicks;
+    pendingTicks = 0;
+    interrupts();
+    return ticks;
+}
+
+#else
+
+static uint32_t lastTickMillis = 0; ///< millis() at the last counted tick.
+
+/**
+ * @brief Starts the scheduler tick from millis().
+ */
+void schedulerBegin() {
+    lastTickMillis = millis();
+}
+
+/**
+ * @brief Takes the milliseconds elapsed since the previous pass as ticks.
+ *
+ * @return Number of ticks.
+ */
+static uint16_t takeTicks() {
+    uint32_t elapsed = millis() - lastTickMillis;
+    if (elapsed > 0xFFFF) {
+        elapsed = 0xFFFF;
+    }
+    lastTickMillis += elapsed;
+    return static_cast<uint16_t>(elapsed);
+}
+
+#endif
+
+/**
+ * @brief Registers a periodic task.
+ *
+ * The task is inserted after any registered task of equal or higher priority and
+ * first runs on the next tick.
+ *
+ * @param name Task name, reported by schedulerReport().
+ * @param task Function to run.
+ * @param period Period in ticks (ms); 0 is treated as 1.
+ * @param priority Run order within a tick; lower values run first.
+ * @return True if registered, false if the task table is full.
+ */
+bool schedulerAddTask(const __FlashStringHelper* name, void (*task)(), uint16_t period, uint8_t priority) {
+    if (taskCount >= MAX_SCHEDULED_TASKS) {
+        return false;
+    }
+    uint8_t index = taskCount;
+    while (index > 0 && tasks[index - 1].priority > priority) {
+        tasks[index] = tasks[index - 1];
+        index--;
+    }
+    tasks[index] = {name, task, period ? period : static_cast<uint16_t>(1), 1, priority, 0, 0};
+    taskCount++;
+    return true;
+}
+
+/**
+ * @brief Runs every task that is due since the previous call.
+ *
+ * Elapsed ticks advance every task's countdown; a task that became due runs once,
+ * however many of its periods elapsed, and the extra ticks are counted as missed.
+ */
+void schedulerRun() {
+    uint16_t ticks = takeTicks();
+    if (ticks == 0) {
+        return;
+    }
+    missedTicks += ticks - 1;
+    for (uint8_t i = 0; i < taskCount; i++) {
+        ScheduledTask& task = tasks[i];
+        if (task.countdown > ticks) {
+            task.countdown -= ticks;
+            continue;
+        }
+        task.countdown = task.period;
+        uint32_t start = micros();
+        task.run();
+        uint32_t elapsed = micros() - start;
+        if (elapsed > task.worstCase) {
+            task.worstCase = elapsed;
+        }
+        task.runs++;
+    }
+}
+
+/**
+ * @brief Clears the execution-time and missed-tick statistics.
+ */
+void schedulerResetStats() {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        tasks[i].runs = 0;
+        tasks[i].worstCase = 0;
+    }
+    missedTicks = 0;
+}
+
+/**
+ * @brief Writes the scheduler statistics to the serial port.
+ */
+void schedulerReport() {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const ScheduledTask& task = tasks[i];
+        Serial.print(F("SCHEDULER,"));
+        Serial.print(task.name);
+        Serial.print(',');
+        Serial.print(task.period);
+        Serial.print(',');
+        Serial.print(task.priority);
+        Serial.print(',');
+        Serial.print(task.runs);
+        Serial.print(',');
+        Serial.println(task.worstCase);
+    }
+    Serial.print(F("SCHEDULER,MISSED_TICKS,"));
+    Serial.println(missedTicks);
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+/**
+ * @file Scheduler.h
+ * @brief Fixed-rate cooperative task scheduler for PROGRAM().
+ *
+ * A hardware timer raises a tick flag about once per millisecond (on AVR, the
+ * Timer0 compare-A interrupt, which fires once per Timer0 overflow at ~976 Hz
+ * without disturbing millis()). schedulerRun() is called from loop() and runs
+ * every task whose period has elapsed, in priority order, so inputs are sampled
+ * at a fixed rate regardless of serial traffic. Tasks run to completion; a tick
+ * that arrives while tasks are still running is counted as missed and folded
+ * into the next pass rather than replayed.
+ *
+ * Each task's worst-case execution time is measured with micros() and reported
+ * by schedulerReport().
+ */
+
+const uint8_t MAX_SCHEDULED_TASKS = 8; ///< Maximum number of tasks that can be registered.
+
+/**
+ * @brief Starts the scheduler tick.
+ *
+ * On targets without the Timer0 tick the scheduler derives ticks from millis().
+ */
+void schedulerBegin();
+
+/**
+ * @brief Registers a periodic task.
+ * @param name Task name, reported by schedulerReport().
+ * @param task Function to run.
+ * @param period Period in ticks (ms).
+ * @param priority Run order within a tick; lower values run first.
+ * @return True if registered, false if the task table is full.
+ */
+bool schedulerAddTask(const __FlashStringHelper* name, void (*task)(), uint16_t period, uint8_t priority);
+
+/**
+ * @brief Runs every task that is due since the previous call.
+ */
+void schedulerRun();
+
+/**
+ * @brief Clears the execution-time and missed-tick statistics.
+ */
+void schedulerResetStats();
+
+/**
+ * @brief Writes the scheduler statistics to the serial port.
+ *
+ * One "SCHEDULER,<name>,<period ms>,<priority>,<runs>,<WCET us>" line per task,
+ * followed by "SCHEDULER,MISSED_TICKS,<count>".
+ */
+void schedulerReport();
+
+#endif // SCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,884 @@
+#include "Session.h"
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "Schedule.h"
+#include "Scheduler.h"
+#include "Profiler.h"
+#include "LoopMonitor.h"
+#include "Command_Utils.h"
+#include "Laser_Utils.h"
+#include "Lever_Utils.h"
+#include "Cue_Utils.h"
+#include "Pump_Utils.h"
+#include "LickCircuit_Utils.h"
+#include "Utils.h"
+#include "Program_Utils.h"
+#include "PulseTrain.h"
+
+/*
+  Sections:
+  - Section 1: Devices and session state shared by every schedule
+  - Section 2: sessionSetup(), sessionLoop(), and sendSetupJSON()
+  - Section 3: Serial commands shared by every schedule
+  - Section 4: Main program structure
+*/
+
+// =======================================================
+// ====================== SECTION 1 ======================
+// =======================================================
+
+// Class instantiations for components
+Lever leverRH(RH_LEVER_PIN);         ///< Right-hand lever object.
+Lever leverLH(LH_LEVER_PIN);         ///< Left-hand lever object.
+Lever* activeLever = &leverRH;       ///< Pointer to the active lever (default: RH).
+Lever* inactiveLever = &leverLH;     ///< Pointer to the inactive lever (default: LH).
+Cue cs(CS_PIN);                      ///< Cue speaker object.
+FastPump<PUMP_PIN> pump;             ///< Pump object, on direct port writes.
+LickCircuit lickCircuit(LICK_CIRCUIT_PIN); ///< Lick circuit object.
+InputSampler inputSampler;           ///< Snapshots lever and lick inputs once per tick.
+FastLaser<LASER_PIN> laser;          ///< Laser object, on direct port writes.
+PulseGenerator imagingTrigger(IMAGING_TRIGGER); ///< Imaging start/stop pulse output.
+
+// Global Boolean variables
+bool setupFinished = false;          ///< Indicates if setup is complete.
+bool programIsRunning = false;       ///< Indicates if the program is running.
+bool linkedToGUI = false;            ///< Indicates if connected to the GUI.
+volatile bool collectFrames = false; ///< Indicates if frame signals are collected.
+
+// Global variables
+uint32_t baudrate = 115200;          ///< Baud rate for serial communication.
+uint32_t differenceFromStartTime;    ///< Offset from program start time (ms).
+uint32_t traceIntervalLength = 0;    ///< Trace interval between cue and infusion (ms).
+uint32_t timeoutIntervalLength = 20000; ///< Timeout period after cue end (ms).
+uint32_t timeoutIntervalStart;       ///< Start timestamp of timeout interval (ms).
+uint32_t timeoutIntervalEnd;         ///< End timestamp of timeout interval (ms).
+uint32_t previousPing = 0;           ///< Last ping timestamp (ms).
+uint32_t pingInterval = 30000;       ///< Ping interval (ms).
+bool pingTelemetry = true;           ///< Sends loop-timing telemetry with the ping, or a bare "ping" line when false.
+bool laserStim = true;               ///< Runs laser stimulation and accepts the laser setting commands.
+EVENT_FORMAT eventFormat = TEXT_FORMAT; ///< Serial format for logged events (default: text).
+EventQueue eventQueue;               ///< Events waiting to be sent over serial.
+FrameQueue frameQueue;               ///< Frame captures queued by frameSignalISR().
+
+// =======================================================
+// ====================== SECTION 2 ======================
+// =======================================================
+
+static const char* sketchName = "";  ///< Sketch name reported at startup and in the setup JSON.
+static const char* sketchVersion = ""; ///< Sketch version reported in the setup JSON.
+
+static void setupTasks();            // Registers the scheduler tasks (Section 4).
+
+/**
+ * @brief Initializes the Arduino and configures pins and devices.
+ * 
+ * Sets up pin modes, attaches interrupts, initializes devices, and starts serial communication.
+ * 
+ * @param name Sketch name (e.g., "operant_FR.ino").
+ * @param version Sketch version (e.g., "v1.0.0").
+ */
+void sessionSetup(const char* name, const char* version) {
+    sketchName = name;
+    sketchVersion = version;
+
+
+    // 2P setup
+    pinMode(IMAGING_TRIGGER, OUTPUT);
+    pinMode(TIMESTAMP_TRIGGER, INPUT);
+#if defined(TIMEBASE_INPUT_CAPTURE)
+    timebaseBegin(recordFrame); // Frames latched by Timer1 input capture
+#else
+    timebaseBegin(nullptr);
+    attachInterrupt(digitalPinToInterrupt(TIMESTAMP_TRIGGER), frameSignalISR, RISING);
+#endif
+
+    // Laser setup
+    pinMode(laser.getPin(), OUTPUT);
+    pulseTrainBegin();
+    laser.disarm();
+    laser.setDuration(30);  // 30 seconds -> 30000 ms
+    laser.setFrequency(20); // 20 Hz
+
+    // RH lever setup
+    pinMode(leverRH.getPin(), INPUT_PULLUP);
+    leverRH.disarm();
+    leverRH.setOrientation(LEVER_RH);
+
+    // LH lever setup
+    pinMode(leverLH.getPin(), INPUT_PULLUP);
+    leverLH.disarm();
+    leverLH.setOrientation(LEVER_LH);
+
+    // CS setup
+    pinMode(cs.getPin(), OUTPUT);
+    cs.disarm();
+
+    // Pump setup
+    pinMode(pump.getPin(), OUTPUT);
+    pump.disarm();
+
+    // Lick circuit setup
+    pinMode(lickCircuit.getPin(), INPUT);
+    lickCircuit.disarm();
+
+    // Input sampling
+    inputSampler.addInput(leverRH.getPin());
+    inputSampler.addInput(leverLH.getPin());
+    inputSampler.addInput(lickCircuit.getPin());
+
+    // Serial connection
+    Serial.begin(baudrate);
+    delay(2000); // Delay to avoid buffer overload
+    Serial.println(sketchName);
+
+    // Task scheduler
+    profilerBegin();
+    setupTasks();
+    setupFinished = true;
+}
+
+/**
+ * @brief Times the loop pass, runs the program, sends queued events, and monitors serial commands.
+ */
+void sessionLoop() {
+    loopMonitorTick();
+    PROGRAM();
+    drainEvents();
+    ProfilerProbe probe(PROBE_SERIAL);
+    monitorSerialCommands();
+}
+
+/**
+ * @brief Sends setup configuration as JSON to the serial monitor.
+ * 
+ * Outputs key configuration parameters for debugging or GUI integration, followed by
+ * the schedule's own settings.
+ */
+void sendSetupJSON() {
+    StaticJsonDocument<256> doc;
+    doc["DOC"] = sketchName;
+    doc["VERSION"] = sketchVersion;
+
+    doc["TRACE INTERVAL LENGTH"] = traceIntervalLength;
+    doc["TIMEOUT INTERVAL LENGTH"] = timeoutIntervalLength;
+    doc["DELTA START TIME"] = differenceFromStartTime;
+    doc["BAUDRATE"] = baudrate;
+
+    doc["CS DURATION"] = cs.getDuration();
+    doc["CS FREQUENCY"] = cs.getFrequency();
+    doc["PUMP INFUSION LENGTH"] = pump.getInfusionDuration();
+    doc["LASER STIM LENGTH"] = laser.getDuration();
+    doc["LASER STIM FREQUENCY"] = laser.getFrequency();
+    doc["LASER PULSE WIDTH"] = laser.getPulseWidth();
+    char waveform[100]; // Nine 10-digit fields and their commas
+    if (laser.hasWaveform()) {
+        const Waveform& w = laser.getWaveform();
+        snprintf(waveform, sizeof(waveform), "%lu,%lu,%lu,%lu,%lu,%lu,%lu,%u,%lu",
+                 static_cast<unsigned long>(w.frequency), static_cast<unsigned long>(w.width),
+                 static_cast<unsigned long>(w.pulses), static_cast<unsigned long>(w.burstPeriod),
+                 static_cast<unsigned long>(w.bursts), static_cast<unsigned long>(w.trainPeriod),
+                 static_cast<unsigned long>(w.trains), static_cast<unsigned>(w.ramp),
+                 static_cast<unsigned long>(w.rampDuration));
+        doc["LASER WAVEFORM"] = static_cast<const char*>(waveform); // Stored by pointer; outlives doc use
+    }
+    doc["LASER STIM MODE"] = laser.getStimMode();
+
+    scheduleSettings(doc);
+
+    serializeJson(doc, Serial);
+    Serial.println('\n');
+}
+
+// =======================================================
+// ====================== SECTION 3 ======================
+// =======================================================
+
+static char commandBuffer[COMMAND_BUFFER_SIZE]; ///< Buffer for incoming serial commands.
+
+/**
+ * @brief Extracts a numeric parameter from a command string.
+ * 
+ * @param cmd Command string (e.g., "SET_RATIO:5").
+ * @param prefix Prefix to match, in flash (e.g., PSTR("SET_RATIO:")).
+ * @return Extracted value as a long integer, or 0 if not found.
+ */
+int32_t extractParam(const char* cmd, const char* prefix) {
+    size_t prefixLen = strlen_P(prefix);
+    if (strncmp_P(cmd, prefix, prefixLen) == 0) {
+        const char* paramStart = cmd + prefixLen;
+        return atol(paramStart);
+    }
+    return 0;
+}
+
+/**
+ * @brief Extracts a comma-separated list of numeric parameters from a command string.
+ * @param cmd Command string (e.g., "LASER_WAVEFORM:20,5000,10").
+ * @param prefix Prefix to match, in flash (e.g., PSTR("LASER_WAVEFORM:")).
+ * @param values Array receiving the values; entries past the last one given are left as they are.
+ * @param count Size of the array.
+ * @return Number of values extracted, or 0 if the prefix does not match.
+ */
+uint8_t extractParams(const char* cmd, const char* prefix, int32_t* values, uint8_t count) {
+    size_t prefixLen = strlen_P(prefix);
+    if (strncmp_P(cmd, prefix, prefixLen) != 0) {
+        return 0;
+    }
+    const char* param = cmd + prefixLen;
+    uint8_t extracted = 0;
+    while (extracted < count) {
+        char* end;
+        int32_t value = strtol(param, &end, 10);
+        if (end == param) {
+            break;
+        }
+        values[extracted++] = value;
+        if (*end != ',') {
+            break;
+        }
+        param = end + 1;
+    }
+    return extracted;
+}
+
+/**
+ * @brief Handles the "LINK" command to connect to the GUI.
+ * @param cmd Command string.
+ */
+static void handleLink(const char* cmd) {
+    connectionJingle("LINK", cs, linkedToGUI);
+}
+
+/**
+ * @brief Handles the "UNLINK" command to disconnect from the GUI.
+ * @param cmd Command string.
+ */
+static void handleUnlink(const char* cmd) {
+    connectionJingle("UNLINK", cs, linkedToGUI);
+}
+
+/**
+ * @brief Handles the "START-PROGRAM" command to begin the program.
+ * @param cmd Command string.
+ */
+static void handleStartProgram(const char* cmd) {
+    startProgram(imagingTrigger);
+    scheduleStart();
+    sendSetupJSON();
+    programIsRunning = true;
+    schedulerResetStats();
+    profilerReset();
+}
+
+/**
+ * @brief Handles the "END-PROGRAM" command to stop the program.
+ * @param cmd Command string.
+ */
+static void handleEndProgram(const char* cmd) {
+    endProgram(imagingTrigger);
+    programIsRunning = false;
+}
+
+/**
+ * @brief Handles the "SET_LOOP_DEADLINE:" command to set the loop period reported as missed.
+ * @param cmd Command string with parameter in microseconds (e.g., "SET_LOOP_DEADLINE:1000").
+ */
+static void handleSetLoopDeadline(const char* cmd) {
+    int32_t value = extractParam(cmd, PSTR("SET_LOOP_DEADLINE:"));
+    if (value > 0) {
+        loopMonitorSetDeadline(value);
+    }
+}
+
+/**
+ * @brief Handles the "SET_TIMEOUT_PERIOD_LENGTH:" command to set timeout length.
+ * @param cmd Command string with parameter.
+ */
+static void handleSetTimeoutPeriodLength(const char* cmd) {
+    int32_t value = extractParam(cmd, PSTR("SET_TIMEOUT_PERIOD_LENGTH:"));
+    timeoutIntervalLength = value;
+}
+
+/**
+ * @brief Handles the "ARM_FRAME" command to enable frame collection.
+ * @param cmd Command string.
+ */
+static void handleArmFrame(const char* cmd) {
+    resetFrameCount();
+    collectFrames = true;
+}
+
+/**
+ * @brief Handles the "DISARM_FRAME" command to disable frame collection.
+ * @param cmd Command string.
+ */
+static void handleDisarmFrame(const char* cmd) {
+    collectFrames = false;
+}
+
+/**
+ * @brief Handles the "ARM_LEVER_RH" command to arm the right-hand lever.
+ * @param cmd Command string.
+ */
+static void handleArmLeverRH(const char* cmd) {
+    leverRH.arm();
+}
+
+/**
+ * @brief Handles the "DISARM_LEVER_RH" command to disarm the right-hand lever.
+ * @param cmd Command string.
+ */
+static void handleDisarmLeverRH(const char* cmd) {
+    leverRH.disarm();
+}
+
+/**
+ * @brief Handles the "ACTIVE_LEVER_RH" command to set RH as active lever.
+ * @param cmd Command string.
+ */
+static void handleActiveLeverRH(const char* cmd) {
+    activeLever = &leverRH;
+    inactiveLever = &leverLH;
+    Serial.print(F("ACTIVE LEVER: "));
+    Serial.println(activeLever->getOrientationName());
+}
+
+/**
+ * @brief Handles the "ARM_LEVER_LH" command to arm the left-hand lever.
+ * @param cmd Command string.
+ */
+static void handleArmLeverLH(const char* cmd) {
+    leverLH.arm();
+}
+
+/**
+ * @brief Handles the "DISARM_LEVER_LH" command to disarm the left-hand lever.
+ * @param cmd Command string.
+ */
+static void handleDisarmLeverLH(const char* cmd) {
+    leverLH.disarm();
+}
+
+/**
+ * @brief Handles the "ACTIVE_LEVER_LH" command to set LH as active lever.
+ * @param cmd Command string.
+ */
+static void handleActiveLeverLH(const char* cmd) {
+    activeLever = &leverLH;
+    inactiveLever = &leverRH;
+    Serial.print(F("ACTIVE LEVER: "));
+    Serial.println(activeLever->getOrientationName());
+}
+
+/**
+ * @brief Handles the "SET_DEBOUNCE_LEVER_RH:" command to set the right-hand lever debounce time.
+ * @param cmd Command string with parameter (ms).
+ */
+static void handleSetDebounceLeverRH(const char* cmd) {
+    int32_t debounceTime = extractParam(cmd, PSTR("SET_DEBOUNCE_LEVER_RH:"));
+    if (debounceTime >= 0) {
+        leverRH.setDebounceTime(debounceTime);
+    }
+}
+
+/**
+ * @brief Handles the "SET_DEBOUNCE_LEVER_LH:" command to set the left-hand lever debounce time.
+ * @param cmd Command string with parameter (ms).
+ */
+static void handleSetDebounceLeverLH(const char* cmd) {
+    int32_t debounceTime = extractParam(cmd, PSTR("SET_DEBOUNCE_LEVER_LH:"));
+    if (debounceTime >= 0) {
+        leverLH.setDebounceTime(debounceTime);
+    }
+}
+
+/**
+ * @brief Handles the "ARM_CS" command to arm the cue speaker.
+ * @param cmd Command string.
+ */
+static void handleArmCS(const char* cmd) {
+    cs.arm();
+}
+
+/**
+ * @brief Handles the "DISARM_CS" command to disarm the cue speaker.
+ * @param cmd Command string.
+ */
+static void handleDisarmCS(const char* cmd) {
+    cs.disarm();
+}
+
+/**
+ * @brief Handles the "SET_FREQUENCY_CS:" command to set cue frequency.
+ * @param cmd Command string with parameter.
+ */
+static void handleSetFrequencyCS(const char* cmd) {
+    int32_t frequency = extractParam(cmd, PSTR("SET_FREQUENCY_CS:"));
+    cs.setFrequency(frequency);
+}
+
+/**
+ * @brief Handles the "SET_DURATION_CS:" command to set cue duration.
+ * @param cmd Command string with parameter.
+ */
+static void handleSetDurationCS(const char* cmd) {
+    int32_t duration = extractParam(cmd, PSTR("SET_DURATION_CS:"));
+    cs.setDuration(duration);
+}
+
+/**
+ * @brief Handles the "ARM_PUMP" command to arm the pump.
+ * @param cmd Command string.
+ */
+static void handleArmPump(const char* cmd) {
+    pump.arm();
+}
+
+/**
+ * @brief Handles the "DISARM_PUMP" command to disarm the pump.
+ * @param cmd Command string.
+ */
+static void handleDisarmPump(const char* cmd) {
+    pump.disarm();
+}
+
+/**
+ * @brief Handles the "SET_TRACE_INTERVAL:" command to set trace interval.
+ * @param cmd Command string with parameter.
+ */
+static void handleSetTraceInterval(const char* cmd) {
+    int32_t value = extractParam(cmd, PSTR("SET_TRACE_INTERVAL:"));
+    traceIntervalLength = value;
+}
+
+/**
+ * @brief Handles the "PUMP_TEST_ON" command to turn the pump on for testing.
+ * @param cmd Command string.
+ */
+static void handlePumpTestOn(const char* cmd) {
+    pump.on();
+}
+
+/**
+ * @brief Handles the "PUMP_TEST_OFF" command to turn the pump off for testing.
+ * @param cmd Command string.
+ */
+static void handlePumpTestOff(const char* cmd) {
+    pump.off();
+}
+
+/**
+ * @brief Handles the "ARM_LASER" command to arm the laser.
+ * @param cmd Command string.
+ */
+static void handleArmLaser(const char* cmd) {
+    laser.arm();
+}
+
+/**
+ * @brief Handles the "DISARM_LASER" command to disarm the laser.
+ * @param cmd Command string.
+ */
+static void handleDisarmLaser(const char* cmd) {
+    laser.disarm();
+}
+
+/**
+ * @brief Handles the "LASER_TEST_ON" command to turn the laser on for testing.
+ * @param cmd Command string.
+ */
+static void handleLaserTestOn(const char* cmd) {
+    laser.on();
+}
+
+/**
+ * @brief Handles the "LASER_TEST_OFF" command to turn the laser off for testing.
+ * @param cmd Command string.
+ */
+static void handleLaserTestOff(const char* cmd) {
+    laser.stopPulses();
+    laser.off();
+}
+
+/**
+ * @brief Handles the "LASER_STIM_MODE_CYCLE" command to set laser to CYCLE mode.
+ * @param cmd Command string.
+ */
+static void handleLaserStimModeCycle(const char* cmd) {
+    laser.setStimMode(CYCLE);
+}
+
+/**
+ * @brief Handles the "LASER_STIM_MODE_ACTIVE-PRESS" command to set laser mode.
+ * @param cmd Command string.
+ */
+static void handleLaserStimModeActivePress(const char* cmd) {
+    laser.setStimMode(ACTIVE_PRESS);
+}
+
+/**
+ * @brief Handles the "LASER_DURATION:" command to set laser duration.
+ * 
+ * Durations whose pulse train is too long to time (see pulseTrainValid()) are rejected.
+ * 
+ * @param cmd Command string with parameter (s).
+ */
+static void handleLaserDuration(const char* cmd) {
+    int32_t duration = extractParam(cmd, PSTR("LASER_DURATION:"));
+    if (duration >= 0 && static_cast<uint32_t>(duration) <= 0xFFFFFFFFUL / 1000 &&
+        pulseTrainValid(laser.getPulseTrain(static_cast<uint32_t>(duration) * 1000))) {
+        laser.setDuration(duration);
+    } else {
+        Serial.print(F("LASER DURATION REJECTED: "));
+        Serial.print(duration);
+        Serial.println(F(" s"));
+    }
+}
+
+/**
+ * @brief Checks that the laser's pulse train can be generated with new settings.
+ * 
+ * Prints a rejection for settings the pulse train cannot time (see pulseTrainValid()).
+ * 
+ * @param frequency Pulse frequency (Hz); 1 Hz is constant stimulation.
+ * @param width Pulse width (us), or 0 for half the period.
+ * @return Boolean indicating the settings are valid.
+ */
+static bool laserPulsesValid(int32_t frequency, int32_t width) {
+    if (frequency == 1 && width >= 0) {
+        return true;
+    }
+    Waveform pulses = {static_cast<uint32_t>(frequency), static_cast<uint32_t>(width ? width : 500000 / frequency),
+                       1, 0, 1, 0, 1, RAMP_NONE, 0};
+    if (frequency > 1 && width >= 0 && pulseTrainValid(pulses)) {
+        return true;
+    }
+    Serial.print(F("LASER PULSE TRAIN REJECTED: "));
+    Serial.print(frequency);
+    Serial.print(F(" Hz, "));
+    Serial.print(width);
+    Serial.println(F(" us"));
+    return false;
+}
+
+/**
+ * @brief Handles the "LASER_FREQUENCY:" command to set laser frequency.
+ * @param cmd Command string with parameter.
+ */
+static void handleLaserFrequency(const char* cmd) {
+    int32_t frequency = extractParam(cmd, PSTR("LASER_FREQUENCY:"));
+    if (laserPulsesValid(frequency, laser.getPulseWidth())) {
+        laser.setFrequency(frequency);
+    }
+}
+
+/**
+ * @brief Handles the "LASER_PULSE_WIDTH:" command to set the laser pulse width.
+ * @param cmd Command string with parameter (us; 0 for half the period).
+ */
+static void handleLaserPulseWidth(const char* cmd) {
+    int32_t width = extractParam(cmd, PSTR("LASER_PULSE_WIDTH:"));
+    if (laserPulsesValid(laser.getFrequency(), width)) {
+        laser.setPulseWidth(width);
+    }
+}
+
+/**
+ * @brief Handles the "LASER_WAVEFORM:" command to load or clear the laser waveform.
+ * 
+ * The descriptor is "<Hz>,<width us>,<pulses per burst>,<burst period ms>,<bursts per train>,
+ * <train period ms>,<trains>,<ramp>,<ramp ms>", with ramp 0 (none), 1 (linear) or 2 (sine).
+ * Trailing fields may be left off for one burst, one train and no ramp. "LASER_WAVEFORM:0"
+ * returns to pulses at LASER_FREQUENCY and LASER_PULSE_WIDTH.
+ * 
+ * @param cmd Command string with parameters.
+ */
+static void handleLaserWaveform(const char* cmd) {
+    int32_t values[9] = {0, 0, 0, 0, 1, 0, 1, RAMP_NONE, 0};
+    uint8_t count = extractParams(cmd, PSTR("LASER_WAVEFORM:"), values, 9);
+    if (count == 1 && values[0] == 0) {
+        laser.clearWaveform();
+        return;
+    }
+    bool negative = false;
+    for (uint8_t i = 0; i < 9; i++) {
+        negative = negative || values[i] < 0;
+    }
+    Waveform waveform = {static_cast<uint32_t>(values[0]), static_cast<uint32_t>(values[1]),
+                         static_cast<uint32_t>(values[2]), static_cast<uint32_t>(values[3]),
+                         static_cast<uint32_t>(values[4]), static_cast<uint32_t>(values[5]),
+                         static_cast<uint32_t>(values[6]), static_cast<RAMP>(values[7]),
+                         static_cast<uint32_t>(values[8])};
+    if (count >= 3 && !negative && values[7] <= RAMP_SINE && pulseTrainValid(waveform)) {
+        laser.setWaveform(waveform);
+    } else {
+        Serial.print(F("LASER WAVEFORM REJECTED: "));
+        Serial.println(cmd);
+    }
+}
+
+/**
+ * @brief Handles the "ARM_LICK_CIRCUIT" command to arm the lick circuit.
+ * @param cmd Command string.
+ */
+static void handleArmLickCircuit(const char* cmd) {
+    lickCircuit.arm();
+}
+
+/**
+ * @brief Handles the "DISARM_LICK_CIRCUIT" command to disarm the lick circuit.
+ * @param cmd Command string.
+ */
+static void handleDisarmLickCircuit(const char* cmd) {
+    lickCircuit.disarm();
+}
+
+/**
+ * @brief Handles the "SET_DEBOUNCE_LICK_CIRCUIT:" command to set the lick circuit debounce time.
+ * @param cmd Command string with parameter (ms).
+ */
+static void handleSetDebounceLickCircuit(const char* cmd) {
+    int32_t debounceTime = extractParam(cmd, PSTR("SET_DEBOUNCE_LICK_CIRCUIT:"));
+    if (debounceTime >= 0) {
+        lickCircuit.setDebounceTime(debounceTime);
+    }
+}
+
+/**
+ * @brief Handles the "SCHEDULER_STATS" command to report task execution times.
+ * @param cmd Command string.
+ */
+static void handleSchedulerStats(const char* cmd) {
+    flushEvents();
+    schedulerReport();
+    Serial.print(F("SCHEDULER,LASER_CYCLE,"));
+    Serial.print(laser.getCycleEpochs());
+    Serial.print(',');
+    Serial.print(laser.getLateCycles());
+    Serial.print(',');
+    Serial.println(laser.getMaxCycleLag());
+}
+
+/**
+ * @brief Handles the "STATS" command to report PROGRAM() stage execution times.
+ * @param cmd Command string.
+ */
+static void handleStats(const char* cmd) {
+    flushEvents();
+    profilerReport();
+}
+
+/**
+ * @brief Handles the "EVENT_FORMAT_TEXT" command to log events as CSV text.
+ * @param cmd Command string.
+ */
+static void handleEventFormatText(const char* cmd) {
+    eventFormat = TEXT_FORMAT;
+}
+
+/**
+ * @brief Handles the "EVENT_FORMAT_BINARY" command to log events as binary frames.
+ * @param cmd Command string.
+ */
+static void handleEventFormatBinary(const char* cmd) {
+    eventFormat = BINARY_FORMAT;
+}
+
+/**
+ * @brief Commands shared by every schedule and their handlers, sorted by prefix for binary search.
+ * 
+ * Prefixes ending in ':' take a parameter; all others must match the whole line. Keep the
+ * entries in ASCII order; a static_assert rejects an unsorted table. The table lives in flash.
+ */
+constexpr Command coreCommands[] PROGMEM = {
+    {"ACTIVE_LEVER_LH", handleActiveLeverLH},
+    {"ACTIVE_LEVER_RH", handleActiveLeverRH},
+    {"ARM_CS", handleArmCS},
+    {"ARM_FRAME", handleArmFrame},
+    {"ARM_LASER", handleArmLaser},
+    {"ARM_LEVER_LH", handleArmLeverLH},
+    {"ARM_LEVER_RH", handleArmLeverRH},
+    {"ARM_LICK_CIRCUIT", handleArmLickCircuit},
+    {"ARM_PUMP", handleArmPump},
+    {"DISARM_CS", handleDisarmCS},
+    {"DISARM_FRAME", handleDisarmFrame},
+    {"DISARM_LASER", handleDisarmLaser},
+    {"DISARM_LEVER_LH", handleDisarmLeverLH},
+    {"DISARM_LEVER_RH", handleDisarmLeverRH},
+    {"DISARM_LICK_CIRCUIT", handleDisarmLickCircuit},
+    {"DISARM_PUMP", handleDisarmPump},
+    {"END-PROGRAM", handleEndProgram},
+    {"EVENT_FORMAT_BINARY", handleEventFormatBinary},
+    {"EVENT_FORMAT_TEXT", handleEventFormatText},
+    {"LINK", handleLink},
+    {"PUMP_TEST_OFF", handlePumpTestOff},
+    {"PUMP_TEST_ON", handlePumpTestOn},
+    {"SCHEDULER_STATS", handleSchedulerStats},
+    {"SET_DEBOUNCE_LEVER_LH:", handleSetDebounceLeverLH},
+    {"SET_DEBOUNCE_LEVER_RH:", handleSetDebounceLeverRH},
+    {"SET_DEBOUNCE_LICK_CIRCUIT:", handleSetDebounceLickCircuit},
+    {"SET_DURATION_CS:", handleSetDurationCS},
+    {"SET_FREQUENCY_CS:", handleSetFrequencyCS},
+    {"SET_LOOP_DEADLINE:", handleSetLoopDeadline},
+    {"SET_TIMEOUT_PERIOD_LENGTH:", handleSetTimeoutPeriodLength},
+    {"SET_TRACE_INTERVAL:", handleSetTraceInterval},
+    {"START-PROGRAM", handleStartProgram},
+    {"STATS", handleStats},
+    {"UNLINK", handleUnlink},
+};
+
+const size_t CORE_COMMAND_COUNT = sizeof(coreCommands) / sizeof(coreCommands[0]); ///< Number of shared commands.
+static_assert(isSorted(coreCommands, CORE_COMMAND_COUNT), "coreCommands[] must be sorted by prefix");
+
+/**
+ * @brief Laser stimulation commands, sorted by prefix; only matched while laserStim is set.
+ * 
+ * ARM_LASER and DISARM_LASER stay in coreCommands[], so every schedule accepts them.
+ */
+constexpr Command laserCommands[] PROGMEM = {
+    {"LASER_DURATION:", handleLaserDuration},
+    {"LASER_FREQUENCY:", handleLaserFrequency},
+    {"LASER_PULSE_WIDTH:", handleLaserPulseWidth},
+    {"LASER_STIM_MODE_ACTIVE-PRESS", handleLaserStimModeActivePress},
+    {"LASER_STIM_MODE_CYCLE", handleLaserStimModeCycle},
+    {"LASER_TEST_OFF", handleLaserTestOff},
+    {"LASER_TEST_ON", handleLaserTestOn},
+    {"LASER_WAVEFORM:", handleLaserWaveform},
+};
+
+const size_t LASER_COMMAND_COUNT = sizeof(laserCommands) / sizeof(laserCommands[0]); ///< Number of laser commands.
+static_assert(isSorted(laserCommands, LASER_COMMAND_COUNT), "laserCommands[] must be sorted by prefix");
+
+/**
+ * @brief Monitors and processes incoming serial commands.
+ * 
+ * Assembles command lines as bytes arrive and executes the matching handler,
+ * never waiting on the serial port. Schedule commands are matched before the shared ones,
+ * and the laser setting commands only while laserStim is set.
+ * Unknown commands, and lines too long for the command buffer, get the invalid-command reply.
+ */
+void monitorSerialCommands() {
+    LINE_STATUS status = setupFinished ? readCommandLine(commandBuffer, COMMAND_BUFFER_SIZE) : LINE_PENDING;
+    if (status == LINE_PENDING) {
+        return;
+    }
+    CommandHandler handler = nullptr;
+    if (status == LINE_READY) { // A line that overran the buffer is never dispatched
+        handler = findCommand(scheduleCommands, SCHEDULE_COMMAND_COUNT, commandBuffer);
+        if (!handler) {
+            handler = findCommand(coreCommands, CORE_COMMAND_COUNT, commandBuffer);
+        }
+        if (!handler && laserStim) {
+            handler = findCommand(laserCommands, LASER_COMMAND_COUNT, commandBuffer);
+        }
+    }
+    if (handler) {
+        handler(commandBuffer);
+    } else {
+        Serial.print(F(">>> Command ["));
+        Serial.print(commandBuffer);
+        Serial.println(F("] is invalid."));
+    }
+}
+
+// =======================================================
+// ====================== SECTION 4 ======================
+// =======================================================
+
+/**
+ * @brief Samples the levers and lick circuit and runs the cue and pump they drive.
+ */
+static void inputTask() {
+    if (linkedToGUI) {
+        inputSampler.sample(); // One snapshot of all inputs per tick
+        {
+            ProfilerProbe probe(PROBE_PRESS_ACTIVE);
+            managePump(&pump); // As a FastPump, so the pin is switched with a direct port write
+            monitorPressing(programIsRunning, activeLever, &cs, &pump, laserStim ? &laser : nullptr);
+        }
+        {
+            ProfilerProbe probe(PROBE_PRESS_INACTIVE);
+            monitorPressing(programIsRunning, inactiveLever, nullptr, nullptr, nullptr);
+        }
+        ProfilerProbe probe(PROBE_LICK);
+        monitorLicking(lickCircuit);
+    }
+}
+
+/**
+ * @brief Runs the schedule's periodic work.
+ */
+static void scheduleTaskRunner() {
+    if (linkedToGUI) {
+        scheduleTask();
+    }
+}
+
+/**
+ * @brief Runs laser stimulation.
+ */
+static void laserTask() {
+    pulseTrainUpdate();
+    if (linkedToGUI && laserStim) {
+        ProfilerProbe probe(PROBE_STIM);
+        manageStim(laser);
+    }
+}
+
+/**
+ * @brief Moves captured frames into the event queue.
+ */
+static void frameTask() {
+    if (linkedToGUI) {
+        ProfilerProbe probe(PROBE_FRAMES);
+        handleFrameSignal();
+    }
+}
+
+/**
+ * @brief Advances the connection jingle and the imaging trigger pulse.
+ * 
+ * Runs whether or not the GUI is linked, so the unlink jingle and the end-of-program
+ * trigger always complete.
+ */
+static void outputTask() {
+    manageJingle();
+    imagingTrigger.update();
+}
+
+/**
+ * @brief Sends the periodic ping.
+ */
+static void pingTask() {
+    if (linkedToGUI) {
+        ProfilerProbe probe(PROBE_PING);
+        pingDevice(previousPing, pingInterval, pingTelemetry);
+    }
+}
+
+/**
+ * @brief Registers the PROGRAM() tasks with the scheduler and starts its tick.
+ * 
+ * Tasks are listed in priority order: inputs first, then the schedule, actuators, frames
+ * and telemetry.
+ */
+static void setupTasks() {
+    schedulerAddTask(F("INPUTS"), inputTask, 1, 0);
+    schedulerAddTask(F("SCHEDULE"), scheduleTaskRunner, 1, 1);
+    schedulerAddTask(F("LASER"), laserTask, 1, 2);
+    schedulerAddTask(F("OUTPUTS"), outputTask, 1, 3);
+    schedulerAddTask(F("FRAMES"), frameTask, 1, 4);
+    schedulerAddTask(F("PING"), pingTask, 1000, 5);
+    schedulerBegin();
+}
+
+/**
+ * @brief Main program function to manage device interactions.
+ * 
+ * Runs the tasks that are due on the fixed-rate scheduler tick (~1 kHz): lever and
+ * lick sampling, the schedule, laser stimulation, frame handling and the ping while
+ * connected to the GUI, and the jingle and imaging trigger outputs at all times.
+ */
+void PROGRAM() {
+    schedulerRun();
+}
\ No newline at end of file
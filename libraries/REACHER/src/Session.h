@@ -0,0 +1,122 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <Arduino.h>
+#include "Lever.h"
+#include "Cue.h"
+#include "Pump.h"
+#include "Laser.h"
+#include "FastPump.h"
+#include "FastLaser.h"
+#include "LickCircuit.h"
+#include "InputSampler.h"
+#include "PulseGenerator.h"
+#include "Event_Utils.h"
+#include "Utils.h"
+#include "Timebase.h"
+#include "Command_Utils.h"
+
+/**
+ * @file Session.h
+ * @brief Devices, session state and main loop shared by every REACHER paradigm.
+ *
+ * A paradigm sketch calls sessionSetup() from setup() and sessionLoop() from
+ * loop(), and implements the schedule interface in Schedule.h. Everything else
+ * (devices, shared serial commands, event log, frame capture and scheduling)
+ * lives here.
+ */
+
+// Pin definitions
+const byte RH_LEVER_PIN = 10;        ///< Right-hand lever pin.
+const byte LH_LEVER_PIN = 13;        ///< Left-hand lever pin.
+const byte CS_PIN = 3;               ///< Conditioned stimulus speaker pin (PWM capable).
+const byte PUMP_PIN = 4;             ///< Pump pin.
+const byte IMAGING_TRIGGER = 9;      ///< Imaging trigger pin.
+#if defined(TIMEBASE_INPUT_CAPTURE)
+const byte TIMESTAMP_TRIGGER = TIMEBASE_CAPTURE_PIN; ///< Frame timestamp trigger pin (Timer1 input capture).
+#else
+const byte TIMESTAMP_TRIGGER = 2;    ///< Frame timestamp trigger pin.
+#endif
+const byte LICK_CIRCUIT_PIN = 5;     ///< Lick circuit pin.
+const byte LASER_PIN = PULSE_TRAIN_PIN; ///< Laser pin (the pulse train engine's output).
+
+#define COMMAND_BUFFER_SIZE 64       ///< Size of the command buffer (fits a LASER_WAVEFORM: descriptor).
+
+extern Lever leverRH;                ///< Right-hand lever object.
+extern Lever leverLH;                ///< Left-hand lever object.
+extern Lever* activeLever;           ///< Pointer to the active lever (default: RH).
+extern Lever* inactiveLever;         ///< Pointer to the inactive lever (default: LH).
+extern Cue cs;                       ///< Cue speaker object.
+extern FastPump<PUMP_PIN> pump;      ///< Pump object, on direct port writes.
+extern LickCircuit lickCircuit;      ///< Lick circuit object.
+extern InputSampler inputSampler;    ///< Snapshots lever and lick inputs once per tick.
+extern FastLaser<LASER_PIN> laser;   ///< Laser object, on direct port writes.
+extern PulseGenerator imagingTrigger; ///< Imaging start/stop pulse output.
+
+extern bool setupFinished;           ///< Indicates if setup is complete.
+extern bool programIsRunning;        ///< Indicates if the program is running.
+extern bool linkedToGUI;             ///< Indicates if connected to the GUI.
+extern volatile bool collectFrames;  ///< Indicates if frame signals are collected.
+
+extern uint32_t baudrate;            ///< Baud rate for serial communication.
+extern uint32_t differenceFromStartTime; ///< Offset from program start time (ms).
+extern uint32_t traceIntervalLength; ///< Trace interval between cue and infusion (ms).
+extern uint32_t timeoutIntervalLength; ///< Timeout period after cue end (ms).
+extern uint32_t timeoutIntervalStart; ///< Start timestamp of timeout interval (ms).
+extern uint32_t timeoutIntervalEnd;  ///< End timestamp of timeout interval (ms).
+extern uint32_t previousPing;        ///< Last ping timestamp (ms).
+extern uint32_t pingInterval;        ///< Ping interval (ms).
+extern bool pingTelemetry;           ///< Sends loop-timing telemetry with the ping, or a bare "ping" line when false.
+extern bool laserStim;               ///< Runs laser stimulation and accepts the laser setting commands.
+extern EVENT_FORMAT eventFormat;     ///< Serial format for logged events.
+extern EventQueue eventQueue;        ///< Events waiting to be sent over serial.
+extern FrameQueue frameQueue;        ///< Frame captures queued by frameSignalISR().
+extern const Command coreCommands[]; ///< Commands shared by every schedule, in PROGMEM, sorted by prefix.
+extern const size_t CORE_COMMAND_COUNT; ///< Number of shared commands.
+
+/**
+ * @brief Initializes the Arduino and configures pins and devices.
+ * @param name Sketch name (e.g., "operant_FR.ino").
+ * @param version Sketch version (e.g., "v1.0.0").
+ */
+void sessionSetup(const char* name, const char* version);
+
+/**
+ * @brief Runs the program, sends queued events, and monitors serial commands.
+ */
+void sessionLoop();
+
+/**
+ * @brief Runs the tasks that are due on the scheduler tick.
+ */
+void PROGRAM();
+
+/**
+ * @brief Sends setup configuration as JSON to the serial monitor.
+ */
+void sendSetupJSON();
+
+/**
+ * @brief Monitors and processes incoming serial commands.
+ */
+void monitorSerialCommands();
+
+/**
+ * @brief Extracts a numeric parameter from a command string.
+ * @param cmd Command string (e.g., "SET_RATIO:5").
+ * @param prefix Prefix to match, in flash (e.g., PSTR("SET_RATIO:")).
+ * @return Extracted value as a long integer, or 0 if not found.
+ */
+int32_t extractParam(const char* cmd, const char* prefix);
+
+/**
+ * @brief Extracts a comma-separated list of numeric parameters from a command string.
+ * @param cmd Command string (e.g., "LASER_WAVEFORM:20,5000,10").
+ * @param prefix Prefix to match, in flash (e.g., PSTR("LASER_WAVEFORM:")).
+ * @param values Array receiving the values; entries past the last one given are left as they are.
+ * @param count Size of the array.
+ * @return Number of values extracted, or 0 if the prefix does not match.
+ */
+uint8_t extractParams(const char* cmd, const char* prefix, int32_t* values, uint8_t count);
+
+#endif // SESSION_H
\ No newline at end of file
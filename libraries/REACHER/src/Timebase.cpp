@@ -0,0 +1,159 @@
+#include "Timebase.h"
+#include <Arduino.h>
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+#define TIMEBASE_ATOMIC ATOMIC_BLOCK(ATOMIC_RESTORESTATE) ///< Runs a block with interrupts disabled.
+#else
+#define TIMEBASE_ATOMIC ///< Single-threaded targets need no guard.
+#endif
+
+static uint64_t epochMicros = 0; ///< Session epoch on the timebase clock (us).
+static uint32_t epochMillis = 0; ///< Session epoch on the millis() clock (ms).
+
+#if defined(TIMEBASE_INPUT_CAPTURE)
+
+const uint32_t TICKS_PER_MICRO = F_CPU / 8000000UL; ///< Timer1 ticks per microsecond at prescaler 8.
+
+static volatile uint32_t timer1Overflows = 0;              ///< Upper bits of the Timer1 count.
+static void (*volatile onCapture)(uint64_t) = nullptr;     ///< Frame capture callback.
+
+/**
+ * @brief Combines a 16-bit Timer1 value with the overflow count.
+ *
+ * Must run with interrupts disabled. If an overflow is pending and the value was
+ * read after the wrap, the pending overflow is counted.
+ *
+ * @param count Timer1 value (TCNT1 or ICR1).
+ * @return Extended Timer1 tick count.
+ */
+static uint64_t extendTicks(uint16_t count) {
+    uint32_t overflows = timer1Overflows;
+    if ((TIFR1 & _BV(TOV1)) && count < 0x8000) {
+        overflows++;
+    }
+    return (static_cast<uint64_t>(overflows) << 16) | count;
+}
+
+/**
+ * @brief Counts Timer1 overflows to extend it to 48 bits.
+ */
+ISR(TIMER1_OVF_vect) {
+    timer1Overflows++;
+}
+
+/**
+ * @brief Reports a frame edge latched by the Timer1 input-capture unit.
+ */
+ISR(TIMER1_CAPT_vect) {
+    uint64_t timestamp = extendTicks(ICR1) / TICKS_PER_MICRO;
+    if (onCapture) {
+        onCapture(timestamp);
+    }
+}
+
+/**
+ * @brief Starts Timer1 free-running at prescaler 8 with rising-edge input capture.
+ *
+ * @param captureHandler Called from the input-capture interrupt with the edge timestamp (us).
+ */
+void timebaseBegin(void (*captureHandler)(uint64_t)) {
+    pinMode(TIMEBASE_CAPTURE_PIN, INPUT);
+    TIMEBASE_ATOMIC {
+        onCapture = captureHandler;
+        TCCR1A = 0;
+        TCCR1B = _BV(ICNC1) | _BV(ICES1) | _BV(CS11); // Noise canceler, rising edge, clk/8
+        TCNT1 = 0;
+        TIFR1 = _BV(ICF1) | _BV(TOV1);
+        TIMSK1 = _BV(ICIE1) | _BV(TOIE1);
+    }
+}
+
+/**
+ * @brief Gets the current time from Timer1.
+ *
+ * @return Time since timebaseBegin() in microseconds.
+ */
+uint64_t timebaseMicros() {
+    uint64_t ticks;
+    TIMEBASE_ATOMIC {
+        ticks = extendTicks(TCNT1);
+    }
+    return ticks / TICKS_PER_MICRO;
+}
+
+#else
+
+static uint32_t lastMicros = 0;     ///< micros() at the previous call.
+static uint32_t microsRollovers = 0; ///< Number of micros() roll-overs seen.
+
+/**
+ * @brief Starts the timebase.
+ *
+ * Without input capture the timebase is derived from micros() and needs no setup.
+ *
+ * @param captureHandler Unused.
+ */
+void timebaseBegin(void (*captureHandler)(uint64_t)) {
+    (void)captureHandler;
+}
+
+/**
+ * @brief Gets the current time by extending micros() to 64 bits.
+ *
+ * @return Time since power-up in microseconds.
+ */
+uint64_t timebaseMicros() {
+    uint64_t timestamp;
+    TIMEBASE_ATOMIC {
+        uint32_t now = micros();
+        if (now < lastMicros) {
+            microsRollovers++;
+        }
+        lastMicros = now;
+        timestamp = (static_cast<uint64_t>(microsRollovers) << 32) | now;
+    }
+    return timestamp;
+}
+
+#endif
+
+/**
+ * @brief Marks the start of the session on both the timebase and millis() clocks.
+ */
+void timebaseStartEpoch() {
+    epochMicros = timebaseMicros();
+    epochMillis = millis();
+}
+
+/**
+ * @brief Converts a timebase timestamp to session time.
+ *
+ * Before the first epoch the session starts at power-up. A timestamp taken
+ * before the epoch (a press or frame captured before START-PROGRAM but logged
+ * after it) is reported as 0 rather than wrapping around.
+ *
+ * @param timestamp Timestamp from timebaseMicros() (us).
+ * @return Time since the session epoch (us), or 0 if before it.
+ */
+uint64_t sessionMicros(uint64_t timestamp) {
+    return timestamp > epochMicros ? timestamp - epochMicros : 0;
+}
+
+/**
+ * @brief Converts a millis() timestamp to session time.
+ *
+ * Used for actuator periods, which are scheduled on the millis() clock. The
+ * 32-bit difference from the epoch is placed on the 64-bit session clock
+ * within 2^31 ms of the current time, so it holds across millis() wraps and
+ * a timestamp before the epoch (a cue or infusion straddling START-PROGRAM)
+ * is reported as 0 rather than wrapping around.
+ *
+ * @param timestamp Timestamp from millis() (ms), within ~24.8 days of now.
+ * @return Time since the session epoch (us), at millisecond resolution, or 0 if before it.
+ */
+uint64_t sessionMicrosFromMillis(uint32_t timestamp) {
+    int64_t now = static_cast<int64_t>(sessionMicros(timebaseMicros()) / 1000);
+    int64_t session = now + static_cast<int32_t>(timestamp - epochMillis - static_cast<uint32_t>(now));
+    return session > 0 ? static_cast<uint64_t>(session) * 1000 : 0;
+}
\ No newline at end of file
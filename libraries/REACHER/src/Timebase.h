@@ -0,0 +1,75 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <Arduino.h>
+#include "Profiler.h"
+
+/**
+ * @file Timebase.h
+ * @brief Microsecond clock shared by input devices, frame capture and the event log.
+ *
+ * timebaseMicros() extends the 32-bit micros() counter (which wraps every ~71.6
+ * minutes) to 64 bits, so timestamps stay monotonic over sessions of any length.
+ * The session epoch is taken at startProgram() and all logged timestamps are
+ * expressed relative to it.
+ *
+ * On an ATmega328P (e.g., Arduino UNO) the clock can instead be driven by Timer1
+ * at 0.5 us resolution, with the frame trigger wired to the Timer1 input-capture
+ * pin (digital pin 8) so that frame edges are latched in hardware, independent
+ * of interrupt latency. Uncomment TIMEBASE_INPUT_CAPTURE below to enable it.
+ * Timer1 is then reserved for the timebase, so it cannot be combined with
+ * REACHER_PROFILE, whose probes run Timer1 at clk/1 with their own overflow
+ * interrupt.
+ */
+
+// #define TIMEBASE_INPUT_CAPTURE ///< Uncomment to timestamp frames with Timer1 input capture.
+
+#if defined(TIMEBASE_INPUT_CAPTURE) && !defined(__AVR_ATmega328P__)
+#error "TIMEBASE_INPUT_CAPTURE is only supported on ATmega328P boards (ICP1 on pin 8)"
+#endif
+
+#if defined(TIMEBASE_INPUT_CAPTURE) && defined(REACHER_PROFILE)
+#error "TIMEBASE_INPUT_CAPTURE and REACHER_PROFILE both need Timer1; enable only one"
+#endif
+
+#if defined(TIMEBASE_INPUT_CAPTURE)
+const byte TIMEBASE_CAPTURE_PIN = 8; ///< Timer1 input-capture pin (ICP1).
+#endif
+
+/**
+ * @brief Starts the timebase.
+ * @param captureHandler Called from the input-capture interrupt with the edge
+ *        timestamp (us); ignored unless TIMEBASE_INPUT_CAPTURE is enabled.
+ */
+void timebaseBegin(void (*captureHandler)(uint64_t));
+
+/**
+ * @brief Gets the current time.
+ *
+ * Safe to call from interrupt service routines. Must be called at least once
+ * per micros() roll-over period (~71 minutes), which loop() always does.
+ *
+ * @return Time since power-up in microseconds.
+ */
+uint64_t timebaseMicros();
+
+/**
+ * @brief Marks the start of the session; later session timestamps count from here.
+ */
+void timebaseStartEpoch();
+
+/**
+ * @brief Converts a timebase timestamp to session time.
+ * @param timestamp Timestamp from timebaseMicros() (us).
+ * @return Time since the session epoch (us), or 0 if before it.
+ */
+uint64_t sessionMicros(uint64_t timestamp);
+
+/**
+ * @brief Converts a millis() timestamp to session time.
+ * @param timestamp Timestamp from millis() (ms), within ~24.8 days of now.
+ * @return Time since the session epoch (us), at millisecond resolution, or 0 if before it.
+ */
+uint64_t sessionMicrosFromMillis(uint32_t timestamp);
+
+#endif // TIMEBASE_H
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "TonePlayer.h"
+#include <Arduino.h>
+
+/**
+ * @brief Constructs an idle TonePlayer.
+ */
+TonePlayer::TonePlayer()
+    : notes(nullptr), noteCount(0), noteIndex(0), noteStart(0), pin(0), playing(false) {}
+
+/**
+ * @brief Starts a sequence, replacing any sequence already playing.
+ * 
+ * @param initPin Output pin.
+ * @param initNotes Notes to play; must outlive the sequence.
+ * @param initNoteCount Number of notes.
+ */
+void TonePlayer::play(byte initPin, const ToneNote* initNotes, uint8_t initNoteCount) {
+    if (playing && initPin != pin) {
+        noTone(pin);
+    }
+    pin = initPin;
+    notes = initNotes;
+    noteCount = initNoteCount;
+    noteIndex = 0;
+    playing = noteCount > 0;
+    if (playing) {
+        noteStart = millis();
+        tone(pin, notes[0].frequency);
+    }
+}
+
+/**
+ * @brief Advances the sequence once the current note has run its length.
+ * 
+ * Stops the tone after the last note.
+ */
+void TonePlayer::update() {
+    if (!playing) {
+        return;
+    }
+    uint32_t now = millis();
+    if (now - noteStart < notes[noteIndex].duration) {
+        return;
+    }
+    noteStart += notes[noteIndex].duration;
+    if (++noteIndex < noteCount) {
+        tone(pin, notes[noteIndex].frequency);
+    } else {
+        noTone(pin);
+        playing = false;
+    }
+}
+
+/**
+ * @brief Checks if a sequence is playing.
+ * 
+ * @return Boolean playing state.
+ */
+bool TonePlayer::isPlaying() const {
+    return playing;
+}
\ No newline at end of file
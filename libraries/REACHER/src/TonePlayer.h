@@ -0,0 +1,59 @@
+#ifndef TONE_PLAYER_H
+#define TONE_PLAYER_H
+
+#include <Arduino.h>
+
+/**
+ * @file TonePlayer.h
+ * @brief Defines the TonePlayer class for playing tone sequences without blocking.
+ */
+
+/**
+ * @struct ToneNote
+ * @brief One note of a tone sequence.
+ */
+struct ToneNote {
+    uint16_t frequency; ///< Tone frequency (Hz).
+    uint16_t duration;  ///< Note length (ms).
+};
+
+/**
+ * @class TonePlayer
+ * @brief Plays a sequence of notes on a pin, advancing from update() instead of delay().
+ */
+class TonePlayer {
+private:
+    const ToneNote* notes; ///< Sequence being played.
+    uint8_t noteCount;     ///< Number of notes in the sequence.
+    uint8_t noteIndex;     ///< Note currently sounding.
+    uint32_t noteStart;    ///< millis() when the current note started.
+    byte pin;              ///< Output pin of the sequence being played.
+    bool playing;          ///< Indicates whether a sequence is playing.
+
+public:
+    /**
+     * @brief Constructor for the TonePlayer class.
+     */
+    TonePlayer();
+
+    /**
+     * @brief Starts a sequence, replacing any sequence already playing.
+     * @param initPin Output pin.
+     * @param initNotes Notes to play; must outlive the sequence.
+     * @param initNoteCount Number of notes.
+     */
+    void play(byte initPin, const ToneNote* initNotes, uint8_t initNoteCount);
+
+    /**
+     * @brief Advances the sequence; call at least once per millisecond.
+     */
+    void update();
+
+    /**
+     * @brief Checks if a sequence is playing.
+     * @return Boolean playing state.
+     */
+    bool isPlaying() const;
+};
+
+#endif // TONE_PLAYER_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "Utils.h"
+#include "Event_Utils.h"
+#include "Timebase.h"
+#include "LoopMonitor.h"
+#include <Arduino.h>
+
+extern volatile bool collectFrames;      ///< Indicates if frame collection is active.
+extern EventQueue eventQueue;            ///< Events waiting to be sent.
+extern FrameQueue frameQueue;            ///< Frames captured by frameSignalISR().
+
+static volatile uint32_t frameCount = 0; ///< Frame signals seen since frames were armed (ISR only).
+static uint16_t reportedFrameDrops = 0;  ///< Frame queue overflow total last reported.
+
+/**
+ * @brief Sends a periodic ping to ensure serial connection.
+ * 
+ * Sends a "200" line at regular intervals to verify connectivity, followed by the
+ * loop-period histogram and missed deadlines since the previous ping (see LoopMonitor.h).
+ * Schedules whose GUI expects the older keep-alive get a bare "ping" line instead.
+ * 
+ * @param previousPing Reference to the last ping time (ms).
+ * @param pingInterval Interval between pings (ms).
+ * @param telemetry Sends the loop-timing telemetry line if true, otherwise "ping".
+ */
+void pingDevice(uint32_t& previousPing, const uint32_t pingInterval, bool telemetry) {
+    uint32_t currentMillis = millis();
+    if (currentMillis - previousPing >= pingInterval) {
+        previousPing = currentMillis;
+        if (telemetry) {
+            loopMonitorReport();
+        } else {
+            Serial.println(F("ping"));
+        }
+    }
+}
+
+/**
+ * @brief Interrupt service routine for frame signal detection.
+ * 
+ * Timestamps the frame signal on the timebase and queues it.
+ */
+void frameSignalISR() {
+    recordFrame(timebaseMicros());
+}
+
+/**
+ * @brief Queues a frame captured at the given time.
+ * 
+ * Called from interrupt context, either by frameSignalISR() or by the timebase's
+ * input-capture interrupt. Every frame is queued with its frame number, so frames
+ * arriving between loop iterations are never overwritten. The frame number
+ * advances even when the queue overflows, leaving a gap the host can detect.
+ * 
+ * @param timestamp Frame edge time from the timebase (us).
+ */
+void recordFrame(uint64_t timestamp) {
+    if (collectFrames) {
+        FrameCapture frame = {static_cast<uint32_t>(timestamp), frameCount++};
+        frameQueue.push(frame);
+    }
+}
+
+/**
+ * @brief Restarts frame numbering at zero.
+ * 
+ * Called when frame collection is armed so that frame numbers count from the
+ * first frame of the session.
+ */
+void resetFrameCount() {
+    noInterrupts();
+    frameCount = 0;
+    interrupts();
+}
+
+/**
+ * @brief Logs frames queued by the ISR and reports any that were lost.
+ * 
+ * Each frame is logged with its timestamp adjusted to program start and its
+ * frame number. The queue keeps the low 32 bits of each timestamp, which are
+ * widened against the current time. A growing overflow total is reported as
+ * "FRAME_TIMESTAMP,DROPPED,<total>".
+ */
+void handleFrameSignal() {
+    uint16_t drops = frameQueue.getDropped();
+    if (drops != reportedFrameDrops && !eventQueue.isFull()) {
+        reportedFrameDrops = drops;
+        logEvent(EVENT_DROPPED, SOURCE_FRAME, DETAIL_NONE, drops, drops);
+    }
+    FrameCapture frame;
+    uint64_t now = timebaseMicros(); // Queued frames are never a micros() roll-over old
+    while (!eventQueue.isFull() && frameQueue.pop(frame)) {
+        uint64_t timestamp = now - static_cast<uint32_t>(static_cast<uint32_t>(now) - frame.timestamp);
+        logEvent(EVENT_FRAME, SOURCE_FRAME, DETAIL_NONE, sessionMicros(timestamp), frame.index);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef UTILS_H
+#define UTILS_H
+
+#include <Arduino.h>
+#include "RingBuffer.h"
+
+/**
+ * @file Utils.h
+ * @brief General utility functions for connectivity and frame handling.
+ */
+
+/**
+ * @struct FrameCapture
+ * @brief A single frame signal captured by frameSignalISR().
+ */
+struct FrameCapture {
+    uint32_t timestamp; ///< Low 32 bits of timebaseMicros() at the frame signal edge.
+    uint32_t index;     ///< Frame number since frames were armed.
+};
+
+typedef RingBuffer<FrameCapture, 16> FrameQueue; ///< Frames waiting to be logged.
+
+/**
+ * @brief Sends a periodic ping with loop-timing telemetry via serial.
+ * @param previousPing Reference to the last ping time (ms).
+ * @param pingInterval Interval between pings (ms).
+ * @param telemetry Sends the loop-timing telemetry line if true, otherwise "ping".
+ */
+void pingDevice(uint32_t& previousPing, const uint32_t pingInterval, bool telemetry);
+
+/**
+ * @brief ISR for queuing frame signal timestamps.
+ */
+void frameSignalISR();
+
+/**
+ * @brief Queues a frame captured at the given time (interrupt context).
+ * @param timestamp Frame edge time from the timebase (us).
+ */
+void recordFrame(uint64_t timestamp);
+
+/**
+ * @brief Restarts frame numbering at zero.
+ */
+void resetFrameCount();
+
+/**
+ * @brief Logs frames queued by the ISR and reports any that were lost.
+ */
+void handleFrameSignal();
+
+#endif // UTILS_H
\ No newline at end of file
@@ -15,6 +15,7 @@
   - An active lever press delays the infusion by resetting the timer, and are labeled as "ACTIVE"
   - All other presses will be denoted as "INACTIVE"
   - Timestamps are adjusted to the start of the program once the program is started (adjusted timestamp = current timestamp - program start time)
+  - Devices, shared serial commands and the main program live in the REACHER library (libraries/REACHER, see Session.h); this sketch only defines the schedule
 
   ---------------------------------------------------------------------
   Defaults:
@@ -22,27 +23,25 @@
   - cue tone length, 1600ms
   - infusion length, 2000ms
   - active lever, right-hand lever
-  - laser pulse duration, 3000ms
+  - laser pulse duration, 30000ms
+  - ping interval, 10000ms ("ping" line, without loop-timing telemetry)
 
   ---------------------------------------------------------------------
   Current pin configuration:
-  - Pin 10, right-hand lever
-  - Pin 13, left-hand lever
-  - Pin 4, pump
+  - Pin 2, trigger for frame timestamp input signals (pin 8 when TIMEBASE_INPUT_CAPTURE is enabled)
   - Pin 3 (PWM capable pin), conditioned stimulus speaker (denoted as "cs") and speaker for linked/unlinked jingle
-  - Pin 2, trigger for frame timestamp input signals
-  - Pin 9, trigger for imaging program start and stop
+  - Pin 4, pump
   - Pin 5, lick circuit
   - Pin 6, laser
+  - Pin 9, trigger for imaging program start and stop
+  - Pin 10, right-hand lever
+  - Pin 13, left-hand lever
 
   ---------------------------------------------------------------------
   Sections:
   - Section 1: Definitions and configurations
   - Section 2: setup() and loop()
-  - Section 3: Utility functions
-  - Section 4: Looped functions
-  - Section 5: Interrupt functions
-  - Section 6: Main program
+  - Section 3: Omission schedule (see Schedule.h)
 
   ++++++++++++++++++++ INFORMATION ++++++++++++++++++++ */
 
@@ -56,51 +55,10 @@
 
 // Libraries
 #include <Arduino.h>
-#include <SoftwareSerial.h>
 #include <ArduinoJson.h>
-#include "Device.h"
-#include "Laser.h"
-#include "Lever.h"
-#include "Cue.h"
-#include "Pump.h"
-#include "LickCircuit.h"
-
-// Pin definitions
-const byte RH_LEVER_PIN = 10;        ///< Right-hand lever pin.
-const byte LH_LEVER_PIN = 13;        ///< Left-hand lever pin.
-const byte CS_PIN = 3;               ///< Conditioned stimulus speaker pin (PWM capable).
-const byte PUMP_PIN = 4;             ///< Pump pin.
-const byte IMAGING_TRIGGER = 9;      ///< Imaging trigger pin.
-const byte TIMESTAMP_TRIGGER = 2;    ///< Frame timestamp trigger pin.
-const byte LICK_CIRCUIT_PIN = 5;     ///< Lick circuit pin.
-const byte LASER_PIN = 6;            ///< Laser pin.
-
-// Class instantiations for components
-Lever leverRH(RH_LEVER_PIN);         ///< Right-hand lever object.
-Lever leverLH(LH_LEVER_PIN);         ///< Left-hand lever object.
-Lever* activeLever = &leverRH;       ///< Pointer to the active lever (default: RH).
-Lever* inactiveLever = &leverLH;     ///< Pointer to the inactive lever (default: LH).
-Cue cs(CS_PIN);                      ///< Cue speaker object.
-Pump pump(PUMP_PIN);                 ///< Pump object.
-LickCircuit lickCircuit(LICK_CIRCUIT_PIN); ///< Lick circuit object.
-Laser laser(LASER_PIN);              ///< Laser object.
-
-// Global Boolean variables
-bool setupFinished = false;          ///< Indicates if setup is complete.
-bool programIsRunning = false;       ///< Indicates if the program is running.
-bool linkedToGUI = false;            ///< Indicates if connected to the GUI.
-volatile bool frameSignalReceived = false; ///< Indicates if a frame signal was received.
+#include <REACHER.h>
 
 // Global variables
-uint32_t baudrate = 115200;          ///< Baud rate for serial communication.
-uint32_t differenceFromStartTime;    ///< Offset from program start time (ms).
-uint32_t traceIntervalLength = 0;    ///< Trace interval between cue and infusion (ms).
-uint32_t timeoutIntervalLength = 20000; ///< Timeout period after an active press (ms).
-uint32_t timeoutIntervalStart;       ///< Start timestamp of timeout interval (ms).
-uint32_t timeoutIntervalEnd;         ///< End timestamp of timeout interval (ms).
-uint32_t previousPing = 0;           ///< Last ping timestamp (ms).
-const uint32_t pingInterval = 10000; ///< Ping interval (ms).
-volatile uint32_t frameSignalTimestamp = 0; ///< Frame signal timestamp (ms).
 uint32_t lastInfusionTime = 0;       ///< Time of the last infusion (ms).
 uint32_t omissionInterval = 20000;   ///< Time required without presses for infusion (ms).
 
@@ -110,54 +68,19 @@ uint32_t omissionInterval = 20000;   ///< Time required without presses for infu
 
 /**
  * @brief Initializes the Arduino and configures pins and devices.
- * 
- * Sets up pin modes, attaches interrupts, initializes devices, and starts serial communication.
  */
 void setup() {
-    // 2P setup
-    pinMode(IMAGING_TRIGGER, OUTPUT);
-    pinMode(TIMESTAMP_TRIGGER, INPUT);
-    attachInterrupt(digitalPinToInterrupt(TIMESTAMP_TRIGGER), frameSignalISR, RISING);
-
-    // Laser setup
-    pinMode(laser.getPin(), OUTPUT);
-    laser.disarm();
-
-    // RH lever setup
-    pinMode(leverRH.getPin(), INPUT_PULLUP);
-    leverRH.disarm();
-    leverRH.setOrientation("RH");
-
-    // LH lever setup
-    pinMode(leverLH.getPin(), INPUT_PULLUP);
-    leverLH.disarm();
-    leverLH.setOrientation("LH");
-
-    // CS setup
-    pinMode(cs.getPin(), OUTPUT);
-    cs.disarm();
-
-    // Pump setup
-    pinMode(pump.getPin(), OUTPUT);
-    pump.disarm();
-
-    // Lick circuit setup
-    pinMode(lickCircuit.getPin(), INPUT);
-    lickCircuit.disarm();
-
-    // Serial connection
-    Serial.begin(baudrate);
-    delay(2000); // Delay to avoid buffer overload
-    Serial.println(SKETCH_NAME);
-    setupFinished = true;
+    pingInterval = 10000;
+    pingTelemetry = false; // The GUI for this schedule expects a bare "ping"
+    laserStim = false;     // No laser stimulation; ARM_LASER and DISARM_LASER are still accepted
+    sessionSetup(SKETCH_NAME, VERSION);
 }
 
 /**
- * @brief Main loop to run the program and monitor serial commands.
+ * @brief Main loop to run the program, send queued events, and monitor serial commands.
  */
 void loop() {
-    PROGRAM();
-    monitorSerialCommands();
+    sessionLoop();
 }
 
 // =======================================================
@@ -165,400 +88,75 @@ void loop() {
 // =======================================================
 
 /**
- * @brief Logs lever press and release data to the serial monitor.
- * 
- * Records press and release timestamps, adjusted by program start time if applicable.
- * 
- * @param lever Reference to a pointer to the Lever object being monitored.
- */
-void pressingDataEntry(Lever*& lever) {
-    String pressEntry;
-    lever->setReleaseTimestamp(millis()); // Set press release timestamp
-    pressEntry = lever->getOrientation() + "_LEVER,";
-    pressEntry += lever->getPressType() + "_PRESS,";
-    if (differenceFromStartTime) {
-        pressEntry += String(lever->getPressTimestamp() - differenceFromStartTime) + ",";
-        pressEntry += String(lever->getReleaseTimestamp() - differenceFromStartTime);
-    } else {
-        pressEntry += String(lever->getPressTimestamp()) + ",";
-        pressEntry += String(lever->getReleaseTimestamp());
-    }
-    Serial.println(pressEntry); // Send data to serial connection
-}
-
-/**
- * @brief Defines the type of lever press.
+ * @brief Defines the type of lever press and resets the omission timer on active presses.
  * 
- * Labels the press as "ACTIVE" if it’s the active lever, otherwise "INACTIVE".
+ * Labels the press as "ACTIVE" if it's the active lever, otherwise "INACTIVE".
  * 
  * @param programRunning Boolean indicating if the program is running.
  * @param lever Reference to a pointer to the Lever object being pressed.
+ * @param cue Pointer to the Cue object (optional).
+ * @param pump Pointer to the Pump object (optional).
+ * @param laser Pointer to the Laser object (optional).
  */
-void definePressActivity(bool programRunning, Lever*& lever) {
+void definePressActivity(bool programRunning, Lever*& lever, Cue* cue, Pump* pump, Laser* laser) {
     if (lever == activeLever) {
-        lever->setPressType("ACTIVE");
+        lever->setPressType(PRESS_ACTIVE);
+        lastInfusionTime = millis(); // Reset omission timer
     } else {
-        lever->setPressType("INACTIVE");
-    }
-}
-
-/**
- * @brief Starts the program and triggers imaging.
- * 
- * Signals the start of the program, sets the time offset, and initializes infusion timing.
- * 
- * @param pin The digital pin to trigger imaging.
- */
-void startProgram(byte pin) {
-    Serial.println();
-    Serial.println("========== PROGRAM START ==========");
-    Serial.println();
-    digitalWrite(pin, HIGH);            // Trigger imaging start
-    delay(50);                          // Ensure data transmission
-    digitalWrite(pin, LOW);             // Finish trigger
-    differenceFromStartTime = millis(); // Set program start offset
-    lastInfusionTime = millis();        // Initialize last infusion time
-}
-
-/**
- * @brief Ends the program and signals imaging stop.
- * 
- * @param pin The digital pin to trigger imaging end.
- */
-void endProgram(byte pin) {
-    Serial.println();
-    Serial.println("========== PROGRAM END ==========");
-    Serial.println();
-    digitalWrite(pin, HIGH); // Trigger imaging end
-    delay(50);
-    digitalWrite(pin, LOW);
-}
-
-/**
- * @brief Plays a jingle to indicate GUI connection status.
- * 
- * Plays an ascending tone for "LINK" and descending for "UNLINK".
- * 
- * @param connected String indicating "LINK" or "UNLINK".
- * @param cue Cue object to play the tone.
- */
-void connectionJingle(String connected, Cue cue) {
-    if (connected == "LINK") {
-        linkedToGUI = true;
-        static int pitch = 500; // Starting tone frequency
-        for (int i = 0; i < 3; i++) {
-            tone(cue.getPin(), pitch, 100);
-            delay(100);
-            noTone(cue.getPin());
-            pitch += 500; // Increase frequency
-        }
-        pitch = 500;              // Reset frequency
-        Serial.println("LINKED"); // Output status
-    } else if (connected == "UNLINK") {
-        linkedToGUI = false;
-        static int pitch = 1500; // Starting tone frequency
-        for (int i = 0; i < 3; i++) {
-            tone(cue.getPin(), pitch, 100);
-            delay(100);
-            noTone(cue.getPin());
-            pitch -= 500; // Decrease frequency
-        }
-        pitch = 1500;               // Reset frequency
-        Serial.println("UNLINKED"); // Output status
+        lever->setPressType(PRESS_INACTIVE);
     }
 }
 
 /**
- * @brief Sends setup configuration as JSON to the serial monitor.
+ * @brief Starts the omission timer at the start of the program.
  */
-void sendSetupJSON() {
-    StaticJsonDocument<200> doc;
-    doc["DOC"] = SKETCH_NAME;
-    doc["VERSION"] = VERSION;
-
-    doc["OMISSION INTERVAL"] = omissionInterval;
-    doc["DELTA START TIME"] = differenceFromStartTime;
-    doc["BAUDRATE"] = baudrate;
-
-    doc["CS DURATION"] = cs.getDuration();
-    doc["CS FREQUENCY"] = cs.getFrequency();
-    doc["PUMP INFUSION LENGTH"] = pump.getInfusionDuration();
-    doc["LASER STIM LENGTH"] = laser.getStimDuration();
-
-    serializeJson(doc, Serial);
-    Serial.println('\n');
+void scheduleStart() {
+    lastInfusionTime = millis();
 }
 
-// =======================================================
-// ====================== SECTION 4 ======================
-// =======================================================
-
 /**
  * @brief Triggers a pump infusion after an omission interval.
  * 
  * Delivers an infusion and cue tone if the omission interval has elapsed without an active press.
  */
-void triggerInfusion() {
+void scheduleTask() {
     uint32_t currentMillis = millis();
     if (programIsRunning && (currentMillis - lastInfusionTime >= omissionInterval)) {
         if (pump.isArmed() && cs.isArmed()) {
-            int32_t timestamp = millis();
+            int32_t timestamp = static_cast<int32_t>(currentMillis);
             pump.setInfusionPeriod(timestamp, 0); // Start infusion immediately
             cs.setOnTimestamp(timestamp);         // Set cue tone period
             cs.setOffTimestamp(timestamp);
-            String infusionEntry = "PUMP,INFUSION,";
-            infusionEntry += differenceFromStartTime ? String(pump.getInfusionStartTimestamp() - differenceFromStartTime) : String(pump.getInfusionStartTimestamp());
-            infusionEntry += ",";
-            infusionEntry += differenceFromStartTime ? String(pump.getInfusionEndTimestamp() - differenceFromStartTime) : String(pump.getInfusionEndTimestamp());
-            Serial.println(infusionEntry);
+            logEvent(EVENT_INFUSION, SOURCE_PUMP, DETAIL_NONE,
+                     sessionMicrosFromMillis(pump.getInfusionStartTimestamp()),
+                     sessionMicrosFromMillis(pump.getInfusionEndTimestamp()));
             lastInfusionTime = currentMillis;
         }
     }
 }
 
 /**
- * @brief Sends a periodic ping to ensure serial connection.
+ * @brief Adds the omission interval to the setup JSON.
+ * @param doc JSON document being built.
  */
-void pingDevice() {
-    uint32_t currentMillis = millis();
-    if (currentMillis - previousPing >= pingInterval) {
-        previousPing = currentMillis;
-        Serial.println("ping");
-    }
-}
-
-/**
- * @brief Controls pump operation based on infusion timestamps.
- * 
- * Turns the pump on during the infusion period and off otherwise, if armed.
- * 
- * @param pump Reference to the Pump object.
- */
-void managePump(Pump& pump) {
-    int32_t timestamp = millis();
-    if (pump.isArmed()) {
-        if (timestamp <= pump.getInfusionEndTimestamp() && timestamp >= pump.getInfusionStartTimestamp()) {
-            pump.on(); // Turn the pump on
-            pump.setRunning(true);
-        } else {
-            pump.off(); // Turn the pump off
-            pump.setRunning(false);
-        }
-    }
-}
-
-/**
- * @brief Controls cue tone operation based on timestamps.
- * 
- * Turns the cue tone on during its assigned period and off otherwise, if armed.
- * 
- * @param cue Reference to the Cue object.
- */
-void manageCue(Cue& cue) {
-    int32_t timestamp = millis();
-    if (cue.isArmed()) {
-        if (timestamp <= cue.getOffTimestamp() && timestamp >= cue.getOnTimestamp()) {
-            cue.on(); // Turn on cue
-            cue.setRunning(true);
-        } else {
-            cue.off(); // Turn cue off
-            cue.setRunning(false);
-        }
-    }
-}
-
-/**
- * @brief Monitors lever pressing with debouncing and resets omission timer.
- * 
- * Detects lever presses, applies debouncing, and resets the infusion timer on active presses.
- * 
- * @param programRunning Boolean indicating if the program is running.
- * @param lever Reference to a pointer to the Lever object.
- */
-void monitorPressing(bool programRunning, Lever*& lever) {
-    static uint32_t lastDebounceTime = 0; // Last time the lever input was toggled
-    const uint32_t debounceDelay = 100;   // Debounce time in milliseconds
-    if (lever->isArmed()) {
-        bool currentLeverState = digitalRead(lever->getPin()); // Read current state
-        if (currentLeverState != lever->getPreviousLeverState()) {
-            lastDebounceTime = millis(); // Reset debouncing timer
-        }
-        if ((millis() - lastDebounceTime) > debounceDelay) {
-            if (currentLeverState != lever->getStableLeverState()) {
-                lever->setStableLeverState(currentLeverState); // Update stable state
-                if (currentLeverState == LOW) { // Lever press detected
-                    lever->setPressTimestamp(millis());
-                    definePressActivity(programRunning, lever);
-                    if (lever->getPressType() == "ACTIVE") {
-                        lastInfusionTime = millis(); // Reset omission timer
-                    }
-                } else { // Lever release detected
-                    lever->setReleaseTimestamp(millis());
-                    pressingDataEntry(lever);
-                }
-            }
-        }
-        lever->setPreviousLeverState(currentLeverState); // Update previous state
-    }
-}
-
-/**
- * @brief Monitors licking activity with debouncing.
- * 
- * Detects lick events, applies debouncing, and logs timestamps.
- * 
- * @param lickSpout Reference to the LickCircuit object.
- */
-void monitorLicking(LickCircuit& lickSpout) {
-    static uint32_t lastDebounceTime = 0; // Last time the lick input was toggled
-    const uint32_t debounceDelay = 25;    // Debounce time in milliseconds
-    if (lickSpout.isArmed()) {
-        bool currentLickState = digitalRead(lickSpout.getPin());
-        if (currentLickState != lickSpout.getPreviousLickState()) {
-            lastDebounceTime = millis();
-        }
-        if ((millis() - lastDebounceTime) > debounceDelay) {
-            if (currentLickState != lickSpout.getStableLickState()) {
-                lickSpout.setStableLickState(currentLickState);
-                if (currentLickState == HIGH) {
-                    lickSpout.setLickTouchTimestamp(millis());
-                } else {
-                    lickSpout.setLickReleaseTimestamp(millis());
-                    String lickEntry = "LICK_CIRCUIT,LICK," +
-                                       String(lickSpout.getLickTouchTimestamp() - differenceFromStartTime) + "," +
-                                       String(lickSpout.getLickReleaseTimestamp() - differenceFromStartTime);
-                    Serial.println(lickEntry);
-                }
-            }
-        }
-        lickSpout.setPreviousLickState(currentLickState);
-    }
-}
-
-/**
- * @brief Monitors and processes incoming serial commands.
- * 
- * Handles commands from the GUI to control the program and devices.
- */
-void monitorSerialCommands() {
-    if (Serial.available() > 0) {
-        String command = Serial.readStringUntil('\n');
-        command.trim();
-
-        if (command == "LINK") {
-            connectionJingle("LINK", cs);
-        } else if (command == "UNLINK") {
-            connectionJingle("UNLINK", cs);
-        } else if (command == "START-PROGRAM") {
-            startProgram(IMAGING_TRIGGER);
-            sendSetupJSON();
-            programIsRunning = true;
-        } else if (command == "END-PROGRAM") {
-            endProgram(IMAGING_TRIGGER);
-            programIsRunning = false;
-            delay(1000);
-        } else if (command.startsWith("SET_OMISSION_INTERVAL:")) {
-            int32_t initOmissionInterval = command.substring(String("SET_OMISSION_INTERVAL:").length()).toInt();
-            omissionInterval = initOmissionInterval;
-        } else if (command == "ARM_LEVER_RH") {
-            leverRH.arm();
-        } else if (command == "DISARM_LEVER_RH") {
-            leverRH.disarm();
-        } else if (command == "ACTIVE_LEVER_RH") {
-            activeLever = &leverRH;
-            inactiveLever = &leverLH;
-            Serial.print("ACTIVE LEVER: ");
-            Serial.println(activeLever->getOrientation());
-        } else if (command == "ARM_LEVER_LH") {
-            leverLH.arm();
-        } else if (command == "DISARM_LEVER_LH") {
-            leverLH.disarm();
-        } else if (command == "ACTIVE_LEVER_LH") {
-            activeLever = &leverLH;
-            inactiveLever = &leverRH;
-            Serial.print("ACTIVE LEVER: ");
-            Serial.println(activeLever->getOrientation());
-        } else if (command == "ARM_CS") {
-            cs.arm();
-        } else if (command == "DISARM_CS") {
-            cs.disarm();
-        } else if (command.startsWith("SET_FREQUENCY_CS:")) {
-            int32_t frequency = command.substring(String("SET_FREQUENCY_CS:").length()).toInt();
-            cs.setFrequency(frequency);
-        } else if (command.startsWith("SET_DURATION_CS:")) {
-            int32_t duration = command.substring(String("SET_DURATION_CS:").length()).toInt();
-            cs.setDuration(duration);
-        } else if (command == "ARM_PUMP") {
-            pump.arm();
-        } else if (command == "DISARM_PUMP") {
-            pump.disarm();
-        } else if (command == "PUMP_TEST_ON") {
-            pump.on();
-        } else if (command == "PUMP_TEST_OFF") {
-            pump.off();
-        } else if (command == "ARM_LASER") {
-            laser.arm();
-        } else if (command == "DISARM_LASER") {
-            laser.disarm();
-        } else if (command == "ARM_LICK_CIRCUIT") {
-            lickCircuit.arm();
-        } else if (command == "DISARM_LICK_CIRCUIT") {
-            lickCircuit.disarm();
-        } else {
-            Serial.println(">>> command " + command + " is invalid.");
-        }
-        delay(50); // Short delay for command processing
-    }
-}
-
-// =======================================================
-// ====================== SECTION 5 ======================
-// =======================================================
-
-/**
- * @brief Interrupt service routine for frame signal detection.
- * 
- * Captures the timestamp of a frame signal, adjusted by the program start time.
- */
-void frameSignalISR() {
-    frameSignalReceived = true;
-    frameSignalTimestamp = millis() - differenceFromStartTime;
+void scheduleSettings(JsonDocument& doc) {
+    doc["OMISSION INTERVAL"] = omissionInterval;
 }
 
 /**
- * @brief Handles frame signal logging.
- * 
- * Logs the frame timestamp to serial when a signal is received.
+ * @brief Handles the "SET_OMISSION_INTERVAL:" command to set the omission interval.
+ * @param cmd Command string with parameter in milliseconds (e.g., "SET_OMISSION_INTERVAL:20000").
  */
-void handleFrameSignal() {
-    if (frameSignalReceived) {
-        noInterrupts(); // Disable interrupts for safe access
-        frameSignalReceived = false;
-        int32_t timestamp = frameSignalTimestamp;
-        interrupts();   // Re-enable interrupts
-        Serial.println("FRAME_TIMESTAMP," + String(timestamp));
-    }
+void handleSetOmissionInterval(const char* cmd) {
+    int32_t value = extractParam(cmd, PSTR("SET_OMISSION_INTERVAL:"));
+    omissionInterval = value;
 }
 
-// =======================================================
-// ====================== SECTION 6 ======================
-// =======================================================
-
 /**
- * @brief Main program function to manage device interactions.
- * 
- * Runs the core logic for lever pressing, licking, cue, pump, and frame handling
- * when connected to the GUI.
+ * @brief Omission commands in flash, sorted by prefix for findCommand().
  */
-void PROGRAM() {
-    if (linkedToGUI) {
-        monitorPressing(programIsRunning, activeLever);
-        monitorPressing(programIsRunning, inactiveLever);
-        monitorLicking(lickCircuit);
-        manageCue(cs);
-        managePump(pump);
-        triggerInfusion();
-        handleFrameSignal();
-        pingDevice();
-    }
-}
\ No newline at end of file
+constexpr Command scheduleCommands[] PROGMEM = {
+    {"SET_OMISSION_INTERVAL:", handleSetOmissionInterval}
+};
+const size_t SCHEDULE_COMMAND_COUNT = sizeof(scheduleCommands) / sizeof(scheduleCommands[0]);
+static_assert(isSorted(scheduleCommands, sizeof(scheduleCommands) / sizeof(scheduleCommands[0])), "scheduleCommands[] must be sorted by prefix");
\ No newline at end of file
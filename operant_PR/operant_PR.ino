@@ -1,75 +1,324 @@
-#include "LickCircuit.h"
+#define SKETCH_NAME "operant_PR.ino" ///< Name of the sketch.
+#define VERSION "v1.0.0"             ///< Version of the sketch.
+
+/* ++++++++++++++++++++ INFORMATION ++++++++++++++++++++
+  Meta data:
+  Josh Boquiren (@thejoshbq on GitHub), Otis Lab
+
+  "Unless the Lord builds the house, those who build it labor in vain.
+  Unless the Lord watches over the city, the watchman stays awake in vain."
+  Psalm 127:1
+
+  ---------------------------------------------------------------------
+  Program notes:
+  - Each reward requires more active lever presses than the last, read step by step from a ratio table: the Richardson-Roberts exponential series (1, 2, 4, 6, 9, 12, 15, 20, 25, 32, ...) in flash by default, an arithmetic series (SET_PRATIO:) or a custom table (PR_TABLE:)
+  - Past the last step of a table the requirement keeps growing by the table's last increment
+  - The breakpoint is reached when no reward has been earned for the breakpoint limit (SET_BREAKPOINT:, s); it is logged once as "<lever>,BREAKPOINT,<last reward>,<detected>", and a later reward re-arms the detection
+  - The active lever press that meets the requirement triggers a cue tone, followed by a trace interval and pump infusion; active presses are labeled as "ACTIVE"
+  - Presses that occur during the cue tone, trace interval, pump infusion, or timeout period will be labeled as a "TIMEOUT" press
+  - All other presses will be denoted as "INACTIVE"
+  - Timestamps are adjusted to the start of the program once the program is started (adjusted timestamp = current timestamp - program start time)
+  - Lever, lick and frame timestamps are captured on a microsecond timebase (see Timebase.h); the text log reports milliseconds
+  - Inputs, laser, frames and ping run as tasks on a ~1 kHz timer tick (see Scheduler.h); "SCHEDULER_STATS" reports per-task worst-case execution times
+  - Devices, shared serial commands and the main program live in the REACHER library (libraries/REACHER, see Session.h); this sketch only defines the schedule
+
+  ---------------------------------------------------------------------
+  Defaults:
+  - ratio table, Richardson-Roberts exponential (PR_TABLE_EXPONENTIAL)
+  - arithmetic ratio increment, 2 presses per reward, first ratio 1 (SET_PRATIO:)
+  - breakpoint limit, 1800s without a reward (SET_BREAKPOINT:, 0 disables, at most 4294s)
+  - trace interval length, 0ms (time between tone and infusion)
+  - timeout period length, 20000ms (time from cue tone end)
+  - cue tone length, 1600ms
+  - infusion length, 2000ms
+  - active lever, right-hand lever
+  - laser pulse duration, 30000ms
+  - lever debounce time, 100ms per lever (SET_DEBOUNCE_LEVER_RH:/SET_DEBOUNCE_LEVER_LH:)
+  - lick circuit debounce time, 25ms (SET_DEBOUNCE_LICK_CIRCUIT:)
+
+  ---------------------------------------------------------------------
+  Current pin configuration:
+  - Pin 2, trigger for frame timestamp input signals (pin 8 when TIMEBASE_INPUT_CAPTURE is enabled)
+  - Pin 3 (PWM capable pin), conditioned stimulus speaker (denoted as "cs") and speaker for linked/unlinked jingle
+  - Pin 4, pump
+  - Pin 5, lick circuit
+  - Pin 6, laser
+  - Pin 9, trigger for imaging program start and stop
+  - Pin 10, right-hand lever
+  - Pin 13, left-hand lever
+
+  ---------------------------------------------------------------------
+  Sections:
+  - Section 1: Definitions and configurations
+  - Section 2: setup() and loop()
+  - Section 3: Progressive ratio schedule (see Schedule.h)
+
+  ++++++++++++++++++++ INFORMATION ++++++++++++++++++++ */
+
+// =======================================================
+// ====================== SECTION 1 ======================
+// =======================================================
+
+// Libraries
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <REACHER.h>
+
+/**
+ * @enum RATIO_TABLE
+ * @brief Sources of the press requirement for each reward.
+ */
+enum RATIO_TABLE : uint8_t { TABLE_EXPONENTIAL, ///< Richardson-Roberts series in flash.
+                             TABLE_ARITHMETIC,  ///< First ratio 1, then ratioIncrement more per reward.
+                             TABLE_CUSTOM       ///< Table uploaded with PR_TABLE:.
+};
+
+const uint8_t CUSTOM_STEP_COUNT = 32;     ///< Steps a custom table can hold.
+const uint8_t TABLE_VALUES_PER_COMMAND = 12; ///< Steps one PR_TABLE: command can carry.
+const int32_t MAX_BREAKPOINT_LIMIT = 4294;  ///< Longest breakpoint limit (s); a BREAKPOINT event must span under 2^32 us.
+
+/**
+ * @brief Richardson-Roberts (1996) exponential series, round(5 * e^(0.2 j) - 5) for j = 1, 2, ...
+ *
+ * Precomputed so a reward costs one flash read rather than an exp().
+ */
+const uint16_t EXPONENTIAL_STEPS[] PROGMEM = {
+    1, 2, 4, 6, 9, 12, 15, 20, 25, 32, 40, 50, 62, 77, 95, 118, 145, 178, 219, 268,
+    328, 402, 492, 603, 737, 901, 1102, 1347, 1646, 2012, 2459, 3004, 3670, 4484, 5478, 6692,
+    8175, 9986, 12198, 14900
+};
+const uint8_t EXPONENTIAL_STEP_COUNT = sizeof(EXPONENTIAL_STEPS) / sizeof(EXPONENTIAL_STEPS[0]); ///< Steps in the series.
+
+// Global variables
+RATIO_TABLE ratioTable = TABLE_EXPONENTIAL;  ///< Source of the press requirements.
+int32_t ratioIncrement = 2;                  ///< Presses added to the requirement after each reward (arithmetic table).
+uint16_t customSteps[CUSTOM_STEP_COUNT];     ///< Uploaded press requirements, one per reward.
+uint8_t customStepCount = 0;                 ///< Steps uploaded.
+uint16_t rewardStep = 0;                     ///< Rewards earned, the index of the current requirement.
+int32_t pressRequirement = 1;                ///< Active presses required for the next reward.
+int32_t stepIncrement = 0;                   ///< Last increase of the requirement, repeated past the end of a table.
+int32_t pressCount = 0;                      ///< Counter for lever presses.
+uint32_t breakpointLimit = 1800000;          ///< Time without a reward that marks the breakpoint (ms), or 0 for none.
+uint32_t lastRewardTime = 0;                 ///< Time of the last reward, or of the program start (ms).
+bool breakpointReached = false;              ///< Indicates if the breakpoint has been logged since the last reward.
+
+// =======================================================
+// ====================== SECTION 2 ======================
+// =======================================================
 
 /**
- * @brief Constructs a LickCircuit object with an initial pin and default settings.
+ * @brief Initializes the Arduino and configures pins and devices.
+ */
+void setup() {
+    sessionSetup(SKETCH_NAME, VERSION);
+}
+
+/**
+ * @brief Main loop to run the program, send queued events, and monitor serial commands.
+ */
+void loop() {
+    sessionLoop();
+}
+
+// =======================================================
+// ====================== SECTION 3 ======================
+// =======================================================
+
+/**
+ * @brief Reads a step of the current ratio table.
+ * @param step Index of the step (rewards earned before it).
+ * @return Press requirement, or 0 past the end of the table.
+ */
+int32_t tableStep(uint16_t step) {
+    if (ratioTable == TABLE_CUSTOM && customStepCount > 0) {
+        return step < customStepCount ? customSteps[step] : 0;
+    }
+    return step < EXPONENTIAL_STEP_COUNT ? pgm_read_word(&EXPONENTIAL_STEPS[step]) : 0;
+}
+
+/**
+ * @brief Moves the press requirement on to the next step after a reward.
+ * 
+ * Constant time: the arithmetic table adds its increment, the others read one entry.
+ * Past the end of a table the last increase is repeated.
+ */
+void advanceRequirement() {
+    rewardStep++;
+    if (ratioTable == TABLE_ARITHMETIC) {
+        pressRequirement += ratioIncrement;
+        return;
+    }
+    int32_t next = tableStep(rewardStep);
+    if (next > 0) {
+        stepIncrement = next > pressRequirement ? next - pressRequirement : 0;
+        pressRequirement = next;
+    } else {
+        pressRequirement += stepIncrement;
+    }
+}
+
+/**
+ * @brief Defines the type of lever press and rewards presses that meet the current requirement.
  * 
- * Initializes a LickCircuit object as a subclass of Device with default states and timestamps.
+ * Labels presses during the cue, infusion, or timeout period as "TIMEOUT", presses on
+ * the active lever otherwise as "ACTIVE", and all other presses as "INACTIVE". Each
+ * reward moves the requirement on to the next step of the ratio table.
  * 
- * @param initPin The digital pin (byte) to which the lick circuit is connected.
+ * @param programRunning Boolean indicating if the program is running.
+ * @param lever Reference to a pointer to the Lever object being pressed.
+ * @param cue Pointer to the Cue object (optional).
+ * @param pump Pointer to the Pump object (optional).
+ * @param laser Pointer to the Laser object (optional).
  */
-LickCircuit::LickCircuit(byte initPin) 
-    : Device(initPin), previousLickState(LOW), stableLickState(LOW), lickTimestamp(0), releaseTimestamp(0) {}
+void definePressActivity(bool programRunning, Lever*& lever, Cue* cue, Pump* pump, Laser* laser) {
+    int32_t timestamp = static_cast<int32_t>(millis()); // Capture initial timestamp
+    if (!cue || !cue->isArmed()) {
+        lever->setPressType(PRESS_INACTIVE);
+    } else if (isTimeoutPeriod(timestamp, cue, pump)) {
+        lever->setPressType(PRESS_TIMEOUT);
+    } else {
+        lever->setPressType(PRESS_ACTIVE);
+        if (pressCount >= pressRequirement - 1) {
+            pressCount = 0;
+            advanceRequirement();
+            lastRewardTime = static_cast<uint32_t>(timestamp);
+            breakpointReached = false;
+            rewardActivePress(programRunning, lever, cue, pump, laser);
+        } else {
+            pressCount++;
+        }
+    }
+}
 
 /**
- * @brief Sets the previous lick state for debouncing.
- * @param initState Boolean indicating the previous state.
+ * @brief Restarts the ratio table and the breakpoint clock at the start of the program.
  */
-void LickCircuit::setPreviousLickState(bool initState) {
-    previousLickState = initState;
+void scheduleStart() {
+    pressCount = 0;
+    rewardStep = 0;
+    stepIncrement = 0;
+    pressRequirement = ratioTable == TABLE_ARITHMETIC ? 1 : tableStep(0);
+    lastRewardTime = millis();
+    breakpointReached = false;
 }
 
 /**
- * @brief Sets the stable lick state after debouncing.
- * @param state Boolean indicating the stable state.
+ * @brief Logs the breakpoint once no reward has been earned for the breakpoint limit.
  */
-void LickCircuit::setStableLickState(bool state) {
-    stableLickState = state;
+void scheduleTask() {
+    if (!programIsRunning || breakpointLimit == 0 || breakpointReached) {
+        return;
+    }
+    uint32_t now = millis();
+    if (now - lastRewardTime >= breakpointLimit) {
+        breakpointReached = true;
+        logEvent(EVENT_BREAKPOINT,
+                 activeLever->getOrientation() == LEVER_RH ? SOURCE_RH_LEVER : SOURCE_LH_LEVER,
+                 DETAIL_NONE, sessionMicrosFromMillis(lastRewardTime), sessionMicrosFromMillis(now));
+    }
 }
 
 /**
- * @brief Sets the timestamp of a lick touch.
- * @param initTimestamp Time in milliseconds when the lick occurred.
+ * @brief Adds the ratio table and breakpoint limit to the setup JSON.
+ * @param doc JSON document being built.
  */
-void LickCircuit::setLickTouchTimestamp(int32_t initTimestamp) {
-    lickTimestamp = initTimestamp;
+void scheduleSettings(JsonDocument& doc) {
+    doc["RATIO TABLE"] = ratioTable;
+    doc["RATIO INCREMENT"] = ratioIncrement;
+    doc["CUSTOM RATIO STEPS"] = customStepCount;
+    doc["BREAKPOINT LIMIT"] = breakpointLimit / 1000;
 }
 
 /**
- * @brief Sets the timestamp of a lick release.
- * @param initTimestamp Time in milliseconds when the release occurred.
+ * @brief Handles the "PR_TABLE:" command to append steps to the custom ratio table.
+ * 
+ * Selects the custom table. Steps must be 1 to 65535 presses; a command with more than
+ * 12 steps, an invalid step or one that would overfill the table is rejected whole.
+ * 
+ * @param cmd Command string with up to 12 steps (e.g., "PR_TABLE:1,2,4,8").
  */
-void LickCircuit::setLickReleaseTimestamp(int32_t initTimestamp) {
-    releaseTimestamp = initTimestamp;
+void handlePRTable(const char* cmd) {
+    int32_t values[TABLE_VALUES_PER_COMMAND + 1]; // One spare to catch a command with too many steps
+    uint8_t count = extractParams(cmd, PSTR("PR_TABLE:"), values, TABLE_VALUES_PER_COMMAND + 1);
+    bool valid = count > 0 && count <= TABLE_VALUES_PER_COMMAND && customStepCount + count <= CUSTOM_STEP_COUNT;
+    for (uint8_t i = 0; i < count; i++) {
+        valid = valid && values[i] >= 1 && values[i] <= 0xFFFF;
+    }
+    if (!valid) {
+        Serial.print(F("PR TABLE REJECTED: "));
+        Serial.println(cmd);
+        return;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        customSteps[customStepCount++] = static_cast<uint16_t>(values[i]);
+    }
+    ratioTable = TABLE_CUSTOM;
 }
 
 /**
- * @brief Retrieves the previous lick state.
- * @return Boolean indicating the previous state.
+ * @brief Handles the "PR_TABLE_CLEAR" command to empty the custom table and return to the exponential series.
+ * @param cmd Command string.
  */
-bool LickCircuit::getPreviousLickState() const {
-    return previousLickState;
+void handlePRTableClear(const char* cmd) {
+    customStepCount = 0;
+    ratioTable = TABLE_EXPONENTIAL;
 }
 
 /**
- * @brief Retrieves the stable lick state.
- * @return Boolean indicating the stable state.
+ * @brief Handles the "PR_TABLE_EXPONENTIAL" command to select the Richardson-Roberts series.
+ * @param cmd Command string.
  */
-bool LickCircuit::getStableLickState() const {
-    return stableLickState;
+void handlePRTableExponential(const char* cmd) {
+    ratioTable = TABLE_EXPONENTIAL;
 }
 
 /**
- * @brief Retrieves the lick touch timestamp.
- * @return Time in milliseconds of the lick.
+ * @brief Handles the "SET_BREAKPOINT:" command to set the breakpoint limit.
+ * 
+ * The BREAKPOINT event runs from the last reward to the breakpoint, and the event
+ * queue holds that span in 32 bits of microseconds, so the limit must be 0 to
+ * MAX_BREAKPOINT_LIMIT seconds; anything else is rejected and leaves the limit unchanged.
+ * 
+ * @param cmd Command string with parameter in seconds (e.g., "SET_BREAKPOINT:1800"), 0 to disable.
+ */
+void handleSetBreakpoint(const char* cmd) {
+    int32_t value = extractParam(cmd, PSTR("SET_BREAKPOINT:"));
+    if (value < 0 || value > MAX_BREAKPOINT_LIMIT) {
+        Serial.print(F("PR BREAKPOINT REJECTED: "));
+        Serial.println(cmd);
+        return;
+    }
+    breakpointLimit = static_cast<uint32_t>(value) * 1000; // Convert to milliseconds
+}
+
+/**
+ * @brief Handles the "SET_PRATIO:" command to select the arithmetic table and set its increment.
+ * 
+ * The increment must be 1 to 65535 presses, like a table step; anything else is rejected
+ * and leaves the table unchanged.
+ * 
+ * @param cmd Command string with parameter (e.g., "SET_PRATIO:2").
  */
-int32_t LickCircuit::getLickTouchTimestamp() const {
-    return lickTimestamp;
+void handleSetPRatio(const char* cmd) {
+    int32_t value = extractParam(cmd, PSTR("SET_PRATIO:"));
+    if (value < 1 || value > 0xFFFF) {
+        Serial.print(F("PR RATIO REJECTED: "));
+        Serial.println(cmd);
+        return;
+    }
+    ratioIncrement = value;
+    ratioTable = TABLE_ARITHMETIC;
 }
 
 /**
- * @brief Retrieves the lick release timestamp.
- * @return Time in milliseconds of the release.
+ * @brief Progressive ratio commands in flash, sorted by prefix for findCommand().
  */
-int32_t LickCircuit::getLickReleaseTimestamp() const {
-    return releaseTimestamp;
-}
\ No newline at end of file
+constexpr Command scheduleCommands[] PROGMEM = {
+    {"PR_TABLE:", handlePRTable},
+    {"PR_TABLE_CLEAR", handlePRTableClear},
+    {"PR_TABLE_EXPONENTIAL", handlePRTableExponential},
+    {"SET_BREAKPOINT:", handleSetBreakpoint},
+    {"SET_PRATIO:", handleSetPRatio}
+};
+const size_t SCHEDULE_COMMAND_COUNT = sizeof(scheduleCommands) / sizeof(scheduleCommands[0]);
+static_assert(isSorted(scheduleCommands, sizeof(scheduleCommands) / sizeof(scheduleCommands[0])), "scheduleCommands[] must be sorted by prefix");
\ No newline at end of file